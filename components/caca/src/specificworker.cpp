@@ -115,7 +115,6 @@ void SpecificWorker::initialize(int period)
 void SpecificWorker::compute()
 {
     //check_both();
-    test_speed();
 }
 
 void SpecificWorker::check_both()
@@ -177,59 +176,6 @@ void SpecificWorker::check_both()
     }
 }
 
-void SpecificWorker::test_speed()
-{
-    auto keys = G->getKeys();
-    random_selector<> selector{};
-    auto t1 = std::chrono::high_resolution_clock::now();
-    for (auto i : iter::range(100000))
-    {
-        auto origen = selector(keys);
-        auto dest = selector(keys);
-        auto orig_n = G->get_node(origen);
-        auto dest_n = G->get_node(dest);
-        if (not orig_n.has_value() or not dest_n.has_value())
-        {
-            std::cout << "nodes " << origen << ", " << dest << std::endl;
-            continue;
-        };
-        // qInfo() << origen << G->get_parent_id(orig_n.value()).value() << dest
-        //         << G->get_parent_id(dest_n.value()).value();
-
-        auto orig_name = orig_n.value().name();
-        auto dest_name = dest_n.value().name();
-        QVec qr = innermodel->transform(dest_name, orig_name).value();
-        //qr.print("qmat:");
-        //innermodel->get_transformation_matrix(dest_name, orig_name).value().print("trans mat: ");
-        //  qInfo() << "-----------------------------";
-    }
-    auto t2 = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>( t2 - t1 ).count();
-    std::cout << duration << std::endl;
-
-    t1 = std::chrono::high_resolution_clock::now();
-    for (auto i : iter::range(100000))
-    {
-        auto origen = selector(keys);
-        auto dest = selector(keys);
-        auto orig_n = G->get_node(origen);
-        auto dest_n = G->get_node(dest);
-        if (not orig_n.has_value() or not dest_n.has_value())
-        {
-            std::cout << "nodes " << origen << ", " << dest << std::endl;
-            continue;
-        };
-
-        auto orig_name = orig_n.value().name();
-        auto dest_name = dest_n.value().name();
-
-        auto r = inner_eigen->transform(dest_name, orig_name);
-    }
-    t2 = std::chrono::high_resolution_clock::now();
-    duration = std::chrono::duration_cast<std::chrono::milliseconds>( t2 - t1 ).count();
-    std::cout << duration << std::endl;
-
-}
 int SpecificWorker::startup_check()
 {
     std::cout << "Startup check" << std::endl;
@@ -99,7 +99,6 @@ private:
     bool startup_check_flag;
 
     void check_both();
-    void test_speed();
 
 };
 
@@ -13,6 +13,7 @@ REGISTER_TYPE(uint_, uint32_t, false)
 REGISTER_TYPE(string_, std::reference_wrapper<const std::string>, false)
 REGISTER_TYPE(vec_byte, std::reference_wrapper<const std::vector<uint8_t>>, false)
 REGISTER_TYPE(vec_float, std::reference_wrapper<const std::vector<float>>, false)
+REGISTER_TYPE(vec_float_b, std::reference_wrapper<const std::vector<float>>, false)
 
 
 ////////////////////////////////////
@@ -20,15 +21,84 @@ REGISTER_TYPE(vec_float, std::reference_wrapper<const std::vector<float>>, false
 ///////////////////////////////////
 
 static void get_node(benchmark::State& state) {
+    std::array<std::string, 4> keys {"world", "omnirobot", "wall0", "floor_plane"};
+    thread_local std::string k = keys[state.thread_index];
     auto G = Graph::get().get_G();
 
     for (auto _ : state) {
-        auto node = G->get_node("world");
+        auto node = G->get_node(k);
        benchmark::DoNotOptimize(node);
     }
 }
 
-BENCHMARK(get_node);
+/*
+ * Every thread reads the same node, as all the agents do with "world" or the robot.
+ * */
+static void get_node_same_key(benchmark::State& state) {
+    auto G = Graph::get().get_G();
+
+    for (auto _ : state) {
+        auto node = G->get_node("world");
+        benchmark::DoNotOptimize(node);
+    }
+}
+
+BENCHMARK(get_node)-> Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(get_node_same_key)-> Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+
+////////////////////////////////////
+//////// Read two attributes
+///////////////////////////////////
+
+/*
+ * Laser-like read done by elastic_band, octomap and grid_map: the whole node is copied to read two 10k vectors.
+ * "read_two_vec_float_len_10000_from_node" measures only the attribute access on a node already held by the agent,
+ * which is the cost a direct read by id would approach.
+ * */
+static std::vector<float> laser_like_input(10000, 1.f);
+
+/*
+ * The two vectors go into a scratch node so "world", used by the rest of the benchmarks, keeps its size.
+ * */
+static std::optional<uint32_t> insert_laser_like_node(const std::shared_ptr<DSR::DSRGraph> &G)
+{
+    DSR::Node n(G->get_agent_id(), "testtype");
+    n.name("bench_laser");
+    G->add_or_modify_attrib_local<vec_float_att>(n, laser_like_input);
+    G->add_or_modify_attrib_local<vec_float_b_att>(n, laser_like_input);
+    return G->insert_node(n);
+}
+
+static void get_node_and_read_two_vec_float_len_10000(benchmark::State& state) {
+    auto G = Graph::get().get_G();
+    auto id = insert_laser_like_node(G);
+
+    for (auto _ : state) {
+        auto n = G->get_node("bench_laser");
+        auto a = G->get_attrib_by_name<vec_float_att>(n.value());
+        auto b = G->get_attrib_by_name<vec_float_b_att>(n.value());
+        benchmark::DoNotOptimize(a.value().get().data());
+        benchmark::DoNotOptimize(b.value().get().data());
+    }
+    G->delete_node(id.value());
+}
+
+static void read_two_vec_float_len_10000_from_node(benchmark::State& state) {
+    auto G = Graph::get().get_G();
+    auto id = insert_laser_like_node(G);
+    auto node = G->get_node(id.value());
+
+    for (auto _ : state) {
+        auto a = G->get_attrib_by_name<vec_float_att>(node.value());
+        auto b = G->get_attrib_by_name<vec_float_b_att>(node.value());
+        benchmark::DoNotOptimize(a.value().get().data());
+        benchmark::DoNotOptimize(b.value().get().data());
+    }
+    G->delete_node(id.value());
+}
+
+BENCHMARK(get_node_and_read_two_vec_float_len_10000);
+BENCHMARK(read_two_vec_float_len_10000_from_node);
 
 ////////////////////////////////////
 //////// Create node
@@ -168,7 +238,7 @@ static void single_attribute_insert_string_len_200(benchmark::State& state) {
     thread_local std::string k = keys[state.thread_index];
     auto G = Graph::get().get_G();
 
-    auto node = G->get_node("world");
+    auto node = G->get_node(k);
     G->insert_attrib_by_name<string__att>(node.value(), long_string_input.next());
 
     // Perform setup here
@@ -185,7 +255,7 @@ static void single_attribute_insert_vecu8_len_200(benchmark::State& state) {
     auto G = Graph::get().get_G();
 
 
-    auto node = G->get_node("world");
+    auto node = G->get_node(k);
     G->insert_attrib_by_name<vec_byte_att>(node.value(), short_vecbyte_input.next());
 
     // Perform setup here
@@ -200,7 +270,7 @@ static void single_attribute_insert_vecu8_len_5000000(benchmark::State& state) {
     thread_local std::string k = keys[state.thread_index];
     auto G = Graph::get().get_G();
 
-    auto node = G->get_node("world");
+    auto node = G->get_node(k);
     G->insert_attrib_by_name<vec_byte_att>(node.value(), long_vecbyte_input.next());
 
     // Perform setup here
@@ -216,7 +286,7 @@ static void single_attribute_insert_vec_float_len_5(benchmark::State& state) {
     auto G = Graph::get().get_G();
 
 
-    auto node = G->get_node("world");
+    auto node = G->get_node(k);
     G->insert_attrib_by_name<vec_float_att>(node.value(), short_vecfloat_input.next());
 
     // Perform setup here
@@ -242,16 +312,16 @@ static void single_attribute_insert_vec_float_len_10000(benchmark::State& state)
     }
 }
 
-BENCHMARK(single_attribute_insert_int)->  Threads(1); //-> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_float)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_uint)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_bool)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_string_len_20)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_string_len_200)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_vecu8_len_5000000)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_vecu8_len_200)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_vec_float_len_5)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_vec_float_len_10000)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_int)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_float)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_uint)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_bool)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_string_len_20)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_string_len_200)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_vecu8_len_5000000)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_vecu8_len_200)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_vec_float_len_5)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_vec_float_len_10000)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
 
 
 
@@ -445,16 +515,16 @@ static void single_attribute_insert_vec_float_len_10000_local(benchmark::State&
     }
 }
 
-BENCHMARK(single_attribute_insert_int_local)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_float_local)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_uint_local)->  Threads(1) ; //-> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_bool_local)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_string_len_20_local)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_string_len_200_local)->  Threads(1) ; //-> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_vecu8_len_5000000_local)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_vecu8_len_200_local)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_vec_float_len_5_local)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
-BENCHMARK(single_attribute_insert_vec_float_len_10000_local)->  Threads(1); // -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_int_local)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_float_local)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_uint_local)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_bool_local)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_string_len_20_local)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_string_len_200_local)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_vecu8_len_5000000_local)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_vecu8_len_200_local)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_vec_float_len_5_local)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
+BENCHMARK(single_attribute_insert_vec_float_len_10000_local)->  Threads(1) -> Threads(2)->  Threads(3) -> Threads(4);
 
 
 
@@ -495,4 +565,98 @@ static void update_5_attr_local_and_update(benchmark::State& state) {
 BENCHMARK(update_5_attr_local_and_update);
 BENCHMARK(update_5_attr);
 
+////////////////////////////////////
+//////// Node creation with its RT edge
+///////////////////////////////////
+
+/*
+ * What people_to_dsr does for every new person: a child node of "world" and the RT edge that places it.
+ * "insert_node_and_edge_RT" uses RT_API, which also rewrites parent and level in the child after the edge.
+ * "insert_node_and_edge_grouped" sets parent and level before insert_node and sends the RT edge as a single delta.
+ * The node is deleted out of the timed region so "world" is left as it was.
+ * */
+static DSR::Node person_like_node(const std::shared_ptr<DSR::DSRGraph> &G, const DSR::Node &parent)
+{
+    static int count = 0;
+    DSR::Node n(G->get_agent_id(), "testtype");
+    n.name("bench_person_" + std::to_string(count++));
+    G->add_or_modify_attrib_local<parent_att>(n, parent.id());
+    G->add_or_modify_attrib_local<level_att>(n, G->get_node_level(parent).value() + 1);
+    return n;
+}
+
+static void insert_node_and_edge_RT(benchmark::State& state) {
+    auto G = Graph::get().get_G();
+    auto rt = G->get_rt_api();
+    auto world = G->get_node("world");
+
+    for (auto _ : state) {
+        auto n = person_like_node(G, world.value());
+        auto id = G->insert_node(n);
+        rt->insert_or_assign_edge_RT(world.value(), id.value(), {1.f, 2.f, 3.f}, {0.f, 0.f, 0.f});
+        state.PauseTiming();
+        G->delete_node(id.value());
+        world = G->get_node("world");
+        state.ResumeTiming();
+    }
+}
+
+static void insert_node_and_edge_grouped(benchmark::State& state) {
+    auto G = Graph::get().get_G();
+    auto world = G->get_node("world");
+
+    for (auto _ : state) {
+        auto n = person_like_node(G, world.value());
+        auto id = G->insert_node(n);
+        DSR::Edge edge(id.value(), world.value().id(), "RT", G->get_agent_id());
+        G->add_or_modify_attrib_local<rt_translation_att>(edge, std::vector<float>{1.f, 2.f, 3.f});
+        G->add_or_modify_attrib_local<rt_rotation_euler_xyz_att>(edge, std::vector<float>{0.f, 0.f, 0.f});
+        G->insert_or_assign_edge(edge);
+        state.PauseTiming();
+        G->delete_node(id.value());
+        state.ResumeTiming();
+    }
+}
+
+BENCHMARK(insert_node_and_edge_RT);
+BENCHMARK(insert_node_and_edge_grouped);
+
+////////////////////////////////////
+//////// Transforms
+///////////////////////////////////
+
+/*
+ * Transforms between random pairs of nodes, as caca's test_speed did with 100k calls.
+ * "transform_same_pair" repeats the laser to world transform that the navigation agents do several times per
+ * cycle, which is the hit path a per-pair transform cache in InnerEigenAPI would serve.
+ * */
+static void transform_random_pairs(benchmark::State& state) {
+    auto G = Graph::get().get_G();
+    auto inner_eigen = G->get_inner_eigen_api();
+    std::vector<std::string> names;
+    for (auto key : G->getKeys())
+        if (auto n = G->get_node(key); n.has_value())
+            names.emplace_back(n.value().name());
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<std::size_t> dis(0, names.size() - 1);
+
+    for (auto _ : state) {
+        auto r = inner_eigen->transform(names[dis(gen)], names[dis(gen)]);
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+static void transform_same_pair(benchmark::State& state) {
+    auto G = Graph::get().get_G();
+    auto inner_eigen = G->get_inner_eigen_api();
+
+    for (auto _ : state) {
+        auto r = inner_eigen->transform("world", "laser_pose");
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+BENCHMARK(transform_random_pairs);
+BENCHMARK(transform_same_pair);
+
 BENCHMARK_MAIN();
\ No newline at end of file
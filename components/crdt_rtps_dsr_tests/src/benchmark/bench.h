@@ -8,6 +8,7 @@
 #include "dsr/api/dsr_api.h"
 #include <iostream>
 #include <string>
+#include <atomic>
 
 // ICE include
 #include <Ice/Ice.h>
@@ -63,7 +64,8 @@ std::string random_string()
 template<class T, std::size_t size = 150>
 class ConstantCircularBuffer {
     std::array<T, size> container;
-    int idx = -1;
+    // shared by all the benchmark threads
+    std::atomic<std::size_t> idx = 0;
 
 public:
     explicit constexpr ConstantCircularBuffer(std::function<T()> fn) {
@@ -74,9 +76,8 @@ public:
         container = std::array<T, size>{l};
     }
 
-    constexpr auto next() -> T& {
-        idx = (idx + 1) % size;
-        return container.at(idx);
+    auto next() -> T& {
+        return container.at(idx.fetch_add(1, std::memory_order_relaxed) % size);
     }
 
 
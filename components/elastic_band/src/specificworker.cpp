@@ -426,8 +426,11 @@ void SpecificWorker::update_node_slot(const std::int32_t id, const std::string &
             {
                 if(dists.value().get().empty() or angles.value().get().empty()) return;
                 //qInfo() << __FUNCTION__ << dists->get().size();
+                // resolve the laser to world chain once per scan; if it fails the scan is dropped, not published
+                const auto laser_to_world = inner_eigen->get_transformation_matrix(world_name, laser_name);
+                if (not laser_to_world.has_value()) return;
                 laser_buffer.put(std::make_tuple(angles.value().get(), dists.value().get()),
-                                 [this](const LaserData &in, std::tuple<QPolygonF,std::vector<QPointF>> &out) {
+                                 [&laser_to_world](const LaserData &in, std::tuple<QPolygonF,std::vector<QPointF>> &out) {
                                      QPolygonF laser_poly;
                                      std::vector<QPointF> laser_cart;
                                      const auto &[angles, dists] = in;
@@ -436,7 +439,7 @@ void SpecificWorker::update_node_slot(const std::int32_t id, const std::string &
                                          //convert laser polar coordinates to cartesian
                                          float x = dist * sin(angle);
                                          float y = dist * cos(angle);
-                                         Mat::Vector3d laserWorld = inner_eigen->transform(world_name,Mat::Vector3d(x, y, 0), laser_name).value();
+                                         Mat::Vector3d laserWorld = laser_to_world.value() * Mat::Vector3d(x, y, 0);
                                          laser_poly << QPointF(x, y);
                                          laser_cart.emplace_back(QPointF(laserWorld.x(), laserWorld.y()));
                                      }
@@ -123,9 +123,14 @@ void SpecificWorker::initialize(int period)
 
 void SpecificWorker::compute()
 {
+    // get head camera node once: it holds both RGB and depth images, several MB each
+    auto cam = G->get_node(viriato_head_camera_name);
+    if (not cam.has_value())
+        qFatal("Terminate in Compute. No node rgbd found");
+
     // read RGBD image from graph
-    RoboCompCameraRGBDSimple::TImage rgb = get_rgb_from_G();
-    RoboCompCameraRGBDSimple::TDepth depth = get_depth_from_G();
+    RoboCompCameraRGBDSimple::TImage rgb = get_rgb_from_G(cam.value());
+    RoboCompCameraRGBDSimple::TDepth depth = get_depth_from_G(cam.value());
 
     // cast RGB image to OpenCV Mat
     cv::Mat img = cv::Mat(rgb.height, rgb.width, CV_8UC3, &rgb.image[0]);
@@ -157,89 +162,71 @@ void SpecificWorker::compute()
 //                     G read utilities
 /////////////////////////////////////////////////////////////////
 
-RoboCompCameraRGBDSimple::TImage SpecificWorker::get_rgb_from_G()
+RoboCompCameraRGBDSimple::TImage SpecificWorker::get_rgb_from_G(const DSR::Node &cam)
 {
-    // get head camera node
-    auto cam = G->get_node(viriato_head_camera_name);
-    if (cam.has_value())
+    // read RGB data attributes from graph 
+    RoboCompCameraRGBDSimple::TImage rgb;
+    try
     {
-        // read RGB data attributes from graph 
-        RoboCompCameraRGBDSimple::TImage rgb;
-        try
-        {
-            auto rgb_data = cam_api->get_rgb_image();
-            const auto width = G->get_attrib_by_name<cam_rgb_width_att>(cam.value());
-            const auto height = G->get_attrib_by_name<cam_rgb_height_att>(cam.value());
-            const auto depth = G->get_attrib_by_name<cam_rgb_depth_att>(cam.value());
-            const auto cam_id = G->get_attrib_by_name<cam_rgb_cameraID_att>(cam.value());
-            const auto focalx = G->get_attrib_by_name<cam_rgb_focalx_att>(cam.value());
-            const auto focaly = G->get_attrib_by_name<cam_rgb_focaly_att>(cam.value());
-            const auto alivetime = G->get_attrib_by_name<cam_rgb_alivetime_att>(cam.value());
-
-            // assign attributes to RoboCompCameraRGBDSimple::TImage
-            rgb.image = rgb_data.value();
-            rgb.width = width.value();
-            rgb.height = height.value();
-            rgb.depth = depth.value();
-            rgb.cameraID = cam_id.value();
-            rgb.focalx = focalx.value();
-            rgb.focaly = focaly.value();
-            rgb.alivetime = alivetime.value();
-
-            return rgb;
-        }
-        catch (const std::exception &e)
-        {
-            std::cout << __FILE__ << __FUNCTION__ << __LINE__ << " " << e.what() << std::endl;
-            std::terminate();
-        }
+        auto rgb_data = G->get_attrib_by_name<cam_rgb_att>(cam);
+        const auto width = G->get_attrib_by_name<cam_rgb_width_att>(cam);
+        const auto height = G->get_attrib_by_name<cam_rgb_height_att>(cam);
+        const auto depth = G->get_attrib_by_name<cam_rgb_depth_att>(cam);
+        const auto cam_id = G->get_attrib_by_name<cam_rgb_cameraID_att>(cam);
+        const auto focalx = G->get_attrib_by_name<cam_rgb_focalx_att>(cam);
+        const auto focaly = G->get_attrib_by_name<cam_rgb_focaly_att>(cam);
+        const auto alivetime = G->get_attrib_by_name<cam_rgb_alivetime_att>(cam);
+
+        // assign attributes to RoboCompCameraRGBDSimple::TImage
+        rgb.image = rgb_data.value();
+        rgb.width = width.value();
+        rgb.height = height.value();
+        rgb.depth = depth.value();
+        rgb.cameraID = cam_id.value();
+        rgb.focalx = focalx.value();
+        rgb.focaly = focaly.value();
+        rgb.alivetime = alivetime.value();
+
+        return rgb;
     }
-    else
+    catch (const std::exception &e)
     {
-        qFatal("Terminate in Compute. No node rgbd found");
+        std::cout << __FILE__ << __FUNCTION__ << __LINE__ << " " << e.what() << std::endl;
+        std::terminate();
     }
 }
 
-RoboCompCameraRGBDSimple::TDepth SpecificWorker::get_depth_from_G()
+RoboCompCameraRGBDSimple::TDepth SpecificWorker::get_depth_from_G(const DSR::Node &cam)
 {
-    // get head camera node
-    auto cam = G->get_node(viriato_head_camera_name);
-    if (cam.has_value())
+    // read depth data attributes from graph
+    RoboCompCameraRGBDSimple::TDepth depth;
+    try
     {
-        // read depth data attributes from graph
-        RoboCompCameraRGBDSimple::TDepth depth;
-        try
-        {
-            auto depth_data = G->get_attrib_by_name<cam_depth_att>(cam.value());
-            const auto width = G->get_attrib_by_name<cam_depth_width_att>(cam.value());
-            const auto height = G->get_attrib_by_name<cam_depth_height_att>(cam.value());
-            const auto cam_id = G->get_attrib_by_name<cam_depth_cameraID_att>(cam.value());
-            const auto focalx = G->get_attrib_by_name<cam_depth_focalx_att>(cam.value());
-            const auto focaly = G->get_attrib_by_name<cam_depth_focaly_att>(cam.value());
-            const auto depth_factor = G->get_attrib_by_name<cam_depthFactor_att>(cam.value());
-            const auto alivetime = G->get_attrib_by_name<cam_depth_alivetime_att>(cam.value());
-
-            // assign attributes to RoboCompCameraRGBDSimple::TDepth
-            depth.depth = depth_data.value();
-            depth.width = width.value();
-            depth.height = height.value();
-            depth.cameraID = cam_id.value();
-            depth.focalx = focalx.value();
-            depth.focaly = focaly.value();
-            depth.depthFactor = depth_factor.value(); // set to 0.1 for viriato_head_camera_sensor
-            depth.alivetime = alivetime.value();
-
-            return depth;
-        }
-        catch(const std::exception& e)
-        {
-            std::cout << __FILE__ << __FUNCTION__ << __LINE__ << " " << e.what() << std::endl;
-            std::terminate();
-        }
+        auto depth_data = G->get_attrib_by_name<cam_depth_att>(cam);
+        const auto width = G->get_attrib_by_name<cam_depth_width_att>(cam);
+        const auto height = G->get_attrib_by_name<cam_depth_height_att>(cam);
+        const auto cam_id = G->get_attrib_by_name<cam_depth_cameraID_att>(cam);
+        const auto focalx = G->get_attrib_by_name<cam_depth_focalx_att>(cam);
+        const auto focaly = G->get_attrib_by_name<cam_depth_focaly_att>(cam);
+        const auto depth_factor = G->get_attrib_by_name<cam_depthFactor_att>(cam);
+        const auto alivetime = G->get_attrib_by_name<cam_depth_alivetime_att>(cam);
+
+        // assign attributes to RoboCompCameraRGBDSimple::TDepth
+        depth.depth = depth_data.value();
+        depth.width = width.value();
+        depth.height = height.value();
+        depth.cameraID = cam_id.value();
+        depth.focalx = focalx.value();
+        depth.focaly = focaly.value();
+        depth.depthFactor = depth_factor.value(); // set to 0.1 for viriato_head_camera_sensor
+        depth.alivetime = alivetime.value();
+
+        return depth;
     }
-    else
+    catch(const std::exception& e)
     {
-        qFatal("Terminate in Compute. No node rgbd found");
+        std::cout << __FILE__ << __FUNCTION__ << __LINE__ << " " << e.what() << std::endl;
+        std::terminate();
     }
 }
 
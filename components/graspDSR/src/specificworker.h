@@ -90,8 +90,8 @@ private:
     vector<vector<float>> project_vertices(vector<vector<float>> vertices, vector<vector<float>> rot, vector<float> trans, vector<vector<float>> intrinsics);
 
 	// G read utilities
-	RoboCompCameraRGBDSimple::TImage get_rgb_from_G();
-	RoboCompCameraRGBDSimple::TDepth get_depth_from_G();
+	RoboCompCameraRGBDSimple::TImage get_rgb_from_G(const DSR::Node &cam);
+	RoboCompCameraRGBDSimple::TDepth get_depth_from_G(const DSR::Node &cam);
 	std::vector<std::vector<float>> get_camera_intrinsics();
 
 	// G injection utilities
@@ -158,8 +158,11 @@ void SpecificWorker::update_node_slot(const std::int32_t id, const std::string &
             if(dists.has_value() and angles.has_value())
             {
                 if(dists.value().get().empty() or angles.value().get().empty()) return;
+                // resolve the laser to world chain once per scan; if it fails the scan is dropped, not published
+                const auto laser_to_world = inner_eigen->get_transformation_matrix(world_name, laser_name);
+                if (not laser_to_world.has_value()) return;
                 laser_buffer.put(std::make_tuple(angles.value().get(), dists.value().get()),
-                                 [this](const LaserData &in, std::vector<Mat::Vector2d> &laser_cart)
+                                 [&laser_to_world](const LaserData &in, std::vector<Mat::Vector2d> &laser_cart)
                                  {
                                      const auto &[angles, dists] = in;
                                      laser_cart.clear(); laser_cart.resize(angles.size());
@@ -169,9 +172,7 @@ void SpecificWorker::update_node_slot(const std::int32_t id, const std::string &
                                          //convert laser polar coordinates to cartesian
                                          float x = dist * sin(angle);
                                          float y = dist * cos(angle);
-                                         Mat::Vector3d laserWorld = inner_eigen->transform(world_name,
-                                                                                           Mat::Vector3d(x, y, 0),
-                                                                                           laser_name).value();
+                                         Mat::Vector3d laserWorld = laser_to_world.value() * Mat::Vector3d(x, y, 0);
                                          laser_cart[i++] = Mat::Vector2d(laserWorld.x()/1000, laserWorld.y()/1000);
                                      }
                                  });
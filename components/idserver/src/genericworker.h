@@ -63,6 +63,7 @@ public:
 
 
 	virtual int DSRGetID_getID() = 0;
+	virtual int DSRGetID_getIDBlock(int size) = 0;
 
 protected:
 
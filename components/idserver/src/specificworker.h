@@ -46,6 +46,7 @@ public:
 
 	//Interface DSRGetID
 	int DSRGetID_getID();
+	int DSRGetID_getIDBlock(int size);
 private:
     void initialize();
     void check_rt_tree(const DSR::Node &node);
@@ -70,6 +71,7 @@ private:
 	std::string dsr_output_path;
 	int output_file_count = 0;
 	bool dsr_write_to_file;
+	std::atomic_bool graph_changed = true;
     int tree_view;
     int graph_view;
     int qscene_2d_view;
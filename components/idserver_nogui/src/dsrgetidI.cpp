@@ -33,3 +33,8 @@ int DSRGetIDI::getID(const Ice::Current&)
 	return worker->DSRGetID_getID();
 }
 
+int DSRGetIDI::getIDBlock(int size, const Ice::Current&)
+{
+	return worker->DSRGetID_getIDBlock(size);
+}
+
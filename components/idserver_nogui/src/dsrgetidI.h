@@ -35,6 +35,7 @@ public:
 	~DSRGetIDI();
 
 	int getID(const Ice::Current&);
+	int getIDBlock(int size, const Ice::Current&);
 
 private:
 
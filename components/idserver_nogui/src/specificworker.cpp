@@ -18,6 +18,7 @@
  */
 #include "specificworker.h"
 #include <QFileDialog>
+#include <limits>
 
 /**
 * \brief Default constructor
@@ -65,12 +66,24 @@ void SpecificWorker::initialize(int period)
     get_max_id_from_G();
 	std::cout<< __FUNCTION__ << ": Graph loaded" << std::endl;  
 	if(dsr_write_to_file)
+	{
+		// only dump G when it has changed since the previous file
+		auto mark_changed = [this]() { graph_changed = true; };
+		connect(G.get(), &DSR::DSRGraph::update_node_signal, this, mark_changed);
+		// remote deltas that only change attributes emit this one alone
+		connect(G.get(), &DSR::DSRGraph::update_attrs_signal, this, mark_changed);
+		connect(G.get(), &DSR::DSRGraph::update_edge_signal, this, mark_changed);
+		connect(G.get(), &DSR::DSRGraph::del_node_signal, this, mark_changed);
+		connect(G.get(), &DSR::DSRGraph::del_edge_signal, this, mark_changed);
 		timer.start(Period);
+	}
 	
 }
 
 void SpecificWorker::compute()
 {
+	if (not graph_changed.exchange(false))
+		return;
 	G->write_to_json_file(dsr_output_path + agent_name + "_" + std::to_string(output_file_count) + ".json");
     output_file_count++;
 }
@@ -98,3 +111,19 @@ int SpecificWorker::DSRGetID_getID()
 }
 
 
+
+// Reserves size consecutive ids in one call and returns the first one. Returns -1, reserving nothing, if size is
+// not positive or the last id of the block would not fit in the int the interface returns
+int SpecificWorker::DSRGetID_getIDBlock(int size)
+{
+	QMutexLocker locker(mutex);
+	if (size <= 0 or node_id > static_cast<std::uint32_t>(std::numeric_limits<int>::max() - size))
+	{
+		std::cout << "Block request of " << size << " ids rejected, last id served: " << node_id << std::endl;
+		return -1;
+	}
+	const auto first = node_id + 1;
+	node_id += size;
+	std::cout << "Block request served with ids: " << first << " to " << node_id << std::endl;
+	return first;
+}
@@ -45,6 +45,7 @@ public:
 
 	//Interface DSRGetID
 	int DSRGetID_getID();
+	int DSRGetID_getIDBlock(int size);
 
 public slots:
 	void compute();
@@ -59,6 +60,7 @@ private:
 	std::string dsr_output_path;
 	int output_file_count = 0;
 	bool dsr_write_to_file;
+	std::atomic_bool graph_changed = true;
 
 	void get_max_id_from_G();
 
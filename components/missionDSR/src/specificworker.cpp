@@ -179,7 +179,14 @@ void SpecificWorker::set_mission(float x, float z, float alpha, std::string obje
 ///////////////////////////////////////////////////////////////////////
 std::optional<Node> SpecificWorker::get_intent_node(bool create)
 {
-    auto intent_nodes = G->get_nodes_by_type("intention");
+    // direct lookup by id before scanning the whole graph. The node can be deleted by other agents, so it is checked
+    if (intent_node_id.has_value())
+    {
+        if (auto node = G->get_node(intent_node_id.value()); node.has_value() and node.value().type() == intention_type)
+            return node;
+        intent_node_id.reset();
+    }
+    auto intent_nodes = G->get_nodes_by_type(intention_type);
     for (auto node : intent_nodes)
     {
         auto parent = G->get_parent_node(node);
@@ -187,7 +194,10 @@ std::optional<Node> SpecificWorker::get_intent_node(bool create)
             std::cout << __FILE__ << __FUNCTION__ << " Intent node without parent" << std::endl;
         
         if(parent.value().name() == robot_name)
+        {
+            intent_node_id = node.id();
             return node;
+        }
     }
     if(create)
     {
@@ -215,6 +225,7 @@ std::optional<Node> SpecificWorker::get_intent_node(bool create)
                         std::cout<<"Error inserting new edge: "<<robot.value().id()<<"->"<<new_id.value()<<" type: has"<<std::endl;
                         std::terminate();
                     }
+                    intent_node_id = new_id.value();
                     return node;
                 }
                 else 
@@ -65,6 +65,7 @@ private:
     
 	// DSR graph
 	std::shared_ptr<DSR::DSRGraph> G;
+	std::optional<std::uint32_t> intent_node_id;  // last known intent node, checked on every use
 
 	//DSR params
 	std::string agent_name;
@@ -123,13 +123,17 @@ void SpecificWorker::initialize(int period)
 
 void SpecificWorker::compute()
 {
-    static octomap::point3d robot_pose{0,0,0};
-    if( const auto r_pose = robot_pose_buffer.try_get(); r_pose.has_value())
-        robot_pose = r_pose.value();
+    // each scan carries the sensor origin taken with the same transform as its points
     if( const auto scan = laser_buffer.try_get(); scan.has_value())
-        octo->insertPointCloud(scan.value(), robot_pose, 10);
+    {
+        const auto &[points, origin] = scan.value();
+        octo->insertPointCloud(points, origin, 10);
+    }
     if( const auto cloud = pointcloud_buffer.try_get(); cloud.has_value())
-        octo->insertPointCloudRays(cloud.value(), robot_pose, 10);
+    {
+        const auto &[points, origin] = cloud.value();
+        octo->insertPointCloudRays(points, origin, 10);
+    }
 
     std::cout << "Total in tree: " << octo->memoryUsage() << std::endl;
     //octo->updateInnerOccupancy();
@@ -401,8 +405,11 @@ void SpecificWorker::update_node_slot(const std::int32_t id, const std::string &
             {
                 if(dists.value().get().empty() or angles.value().get().empty()) return;
                 //qInfo() << __FUNCTION__ << dists->get().size();
+                // resolve the laser to world chain once per scan; if it fails the scan is dropped, not published
+                const auto laser_to_world = inner_eigen->get_transformation_matrix(world_name, laser_name);
+                if (not laser_to_world.has_value()) return;
                 laser_buffer.put(std::make_tuple(angles.value().get(), dists.value().get()),
-                                 [this](const LaserData &in, octomap::Pointcloud &out) {
+                                 [&laser_to_world](const LaserData &in, std::tuple<octomap::Pointcloud, octomap::point3d> &out) {
                                      const auto &[angles, dists] = in;
                                      Mat::Vector3d laser_world;
                                      octomap::Pointcloud pointcloud;
@@ -410,34 +417,34 @@ void SpecificWorker::update_node_slot(const std::int32_t id, const std::string &
                                      {
                                          //convert laser polar coordinates to cartesian
                                          float x = dist * sin(angle); float y = dist * cos(angle); float z = 10;
-                                         laser_world = inner_eigen->transform(world_name,Mat::Vector3d(x, y, z), laser_name).value();
+                                         laser_world = laser_to_world.value() * Mat::Vector3d(x, y, z);
                                          //qInfo() << laser_world.x() << laser_world.y() << laser_world.z();
                                          pointcloud.push_back(laser_world.x()/1000., laser_world.y()/1000., laser_world.z()/1000.);
                                      }
-                                     out = pointcloud;
+                                     const Mat::Vector3d origin = laser_to_world.value() * Mat::Vector3d(0, 0, 0);
+                                     out = std::make_tuple(pointcloud, octomap::point3d(origin.x()/1000., origin.y()/1000., origin.z()/1000.));
                                  });
             }
         }
     }
-    else if (type == omnirobot_type)    // Laser node updated
-    {
-        if(auto r = inner_eigen->transform(world_name, robot_name); r.has_value())
-            robot_pose_buffer.put(octomap::point3d(r.value().x(), r.value().y(), r.value().z()));
-    }
     if (type == rgbd_type)    // Laser node updated
         if( auto node = G->get_node(id); node.has_value())
         {
-            if( std::optional<std::vector<std::tuple<float,float,float>>> depth_data_o = G->get_pointcloud(node.value(), world_name, 10); depth_data_o.has_value())
+            // camera origin read together with the cloud, so both come from the same pose
+            const auto camera_world = inner_eigen->transform(world_name, node.value().name());
+            if( std::optional<std::vector<std::tuple<float,float,float>>> depth_data_o = G->get_pointcloud(node.value(), world_name, 10);
+                depth_data_o.has_value() and camera_world.has_value())
             {
+                const octomap::point3d origin(camera_world.value().x() / 1000, camera_world.value().y() / 1000, camera_world.value().z() / 1000);
                 pointcloud_buffer.put(depth_data_o.value(), //lambda transforms from float tuple to octomap::pointcloud and changes to meters
-                            [this](const std::vector<std::tuple<float,float,float>> &depth_data, octomap::Pointcloud &out) {
+                            [origin](const std::vector<std::tuple<float,float,float>> &depth_data, std::tuple<octomap::Pointcloud, octomap::point3d> &out) {
                                 octomap::Pointcloud pointcloud;
                                 for (const auto &[x, y, z] : depth_data)
                                 {
                                     pointcloud.push_back(x / 1000, y / 1000,
                                                          z / 1000);  //change to write on out directly after clearing it
                                 }
-                                out = pointcloud;
+                                out = std::make_tuple(pointcloud, origin);
                             });
             }
         }
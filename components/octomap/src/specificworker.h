@@ -81,9 +81,9 @@ private:
 
 
     using LaserData = std::tuple<std::vector<float>, std::vector<float>>;  //<angles, dists>
-    DoubleBuffer<LaserData, octomap::Pointcloud> laser_buffer;
-    DoubleBuffer<octomap::point3d, octomap::point3d> robot_pose_buffer;
-    DoubleBuffer<std::vector<std::tuple<float,float,float>>, octomap::Pointcloud> pointcloud_buffer;
+    // scans are stored with the sensor origin in world coordinates at the time they were transformed
+    DoubleBuffer<LaserData, std::tuple<octomap::Pointcloud, octomap::point3d>> laser_buffer;
+    DoubleBuffer<std::vector<std::tuple<float,float,float>>, std::tuple<octomap::Pointcloud, octomap::point3d>> pointcloud_buffer;
     //DoubleBuffer<std::vector<float>, std::vector<float>> pointcloud_buffer;
 
     std::shared_ptr<Collisions> collisions;
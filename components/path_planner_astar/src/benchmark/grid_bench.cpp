@@ -0,0 +1,124 @@
+//
+// Grid benchmarks on the grid files stored with the component
+//
+
+#include "../grid.cpp"
+#include <benchmark/benchmark.h>
+#include <random>
+
+static const std::string simscene_grid_file = std::string(PATH_PLANNER_ASTAR_DIR) + "/viriato-200-vrep.simscene.grid";
+
+// outer region of autonomyLab_complete.simscene with the 200 mm tiles the grid file was saved with
+static Grid<>::Dimensions simscene_dimensions()
+{
+    Grid<>::Dimensions dim;
+    dim.TILE_SIZE = 200;
+    dim.HMIN = -7500; dim.VMIN = -7500;
+    dim.WIDTH = 15000; dim.HEIGHT = 15000;
+    return dim;
+}
+
+////////////////////////////////////
+//////// Initialize
+///////////////////////////////////
+
+/*
+ * Startup path of the agent when a grid file exists: allocate the cells and read them from the file.
+ * */
+static void initialize_from_file(benchmark::State& state) {
+    for (auto _ : state) {
+        Grid<> grid;
+        grid.initialize(nullptr, nullptr, simscene_dimensions(), true, simscene_grid_file);
+        benchmark::DoNotOptimize(grid.size());
+    }
+}
+
+BENCHMARK(initialize_from_file)->Unit(benchmark::kMillisecond);
+
+// keys of all cells in row-major order and the free ones, built with the API the unordered_map Grid also had
+static std::vector<Grid<>::Key> all_keys(const Grid<>::Dimensions &dim)
+{
+    std::vector<Grid<>::Key> keys;
+    for (long int z = dim.VMIN; z < dim.VMIN + dim.HEIGHT; z += dim.TILE_SIZE)
+        for (long int x = dim.HMIN; x < dim.HMIN + dim.WIDTH; x += dim.TILE_SIZE)
+            keys.emplace_back(x, z);
+    return keys;
+}
+
+static std::vector<Grid<>::Key> free_keys(Grid<> &grid)
+{
+    std::vector<Grid<>::Key> keys;
+    for (const auto &k : all_keys(grid.dim))
+        if (grid.isFree(k))
+            keys.push_back(k);
+    return keys;
+}
+
+////////////////////////////////////
+//////// Cell lookups
+///////////////////////////////////
+
+/*
+ * One getCell per cell of the grid, the lookup every planner query is made of.
+ * */
+static void get_cell_all_cells(benchmark::State& state) {
+    Grid<> grid;
+    grid.initialize(nullptr, nullptr, simscene_dimensions(), true, simscene_grid_file);
+    const auto keys = all_keys(grid.dim);
+
+    for (auto _ : state) {
+        std::size_t free = 0;
+        for (const auto &k : keys)
+            free += std::get<1>(grid.getCell(k)).free;
+        benchmark::DoNotOptimize(free);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+BENCHMARK(get_cell_all_cells)->Unit(benchmark::kMicrosecond);
+
+/*
+ * The 8 neighbours of every cell, as a search expands them.
+ * */
+static void neighboors_8_all_cells(benchmark::State& state) {
+    Grid<> grid;
+    grid.initialize(nullptr, nullptr, simscene_dimensions(), true, simscene_grid_file);
+    const auto keys = all_keys(grid.dim);
+
+    for (auto _ : state) {
+        std::size_t n = 0;
+        for (const auto &k : keys)
+            n += grid.neighboors_8(k).size();
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+BENCHMARK(neighboors_8_all_cells)->Unit(benchmark::kMicrosecond);
+
+////////////////////////////////////
+//////// Compute path
+///////////////////////////////////
+
+/*
+ * Random start and goal pairs over the free cells of the stored grid, with a fixed seed so runs are comparable.
+ * Pairs in different components are included, as they are the worst case of a search.
+ * */
+static void compute_path_random_pairs(benchmark::State& state) {
+    Grid<> grid;
+    grid.initialize(nullptr, nullptr, simscene_dimensions(), true, simscene_grid_file);
+    std::vector<QPointF> free_cells;
+    for (const auto &k : free_keys(grid))
+        free_cells.emplace_back(k.x, k.z);
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<std::size_t> dis(0, free_cells.size() - 1);
+
+    for (auto _ : state) {
+        auto path = grid.computePath(free_cells[dis(gen)], free_cells[dis(gen)]);
+        benchmark::DoNotOptimize(path);
+    }
+}
+
+BENCHMARK(compute_path_random_pairs)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
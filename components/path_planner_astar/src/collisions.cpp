@@ -24,10 +24,20 @@ void Collisions::initialize(const std::shared_ptr<DSR::DSRGraph> &graph_,const s
     std::cout << __FILE__ << __FUNCTION__ << " " << ls.size() << "objects read for exclusion list" << std::endl;
     foreach(const QString &s, ls)
         excludedNodes.insert(s.toStdString());
+    if (auto dir = params_->find("BVHCacheDir"); dir != params_->end())
+        bvh_cache_dir = dir->second.value;
 
     // Compute the list of meshes that correspond to robot, world and possibly some additionally excluded ones
     robotNodes.clear(); restNodes.clear();
     recursiveIncludeMeshes(G->get_node_root().value(), robot_name, false, robotNodes, restNodes, excludedNodes);
+    auto inner_eigen = G->get_inner_eigen_api();
+    for (const auto &out : restNodes)
+        place(inner_eigen, out);
+    build_world_manager();
+    index_world_meshes();
+    for (auto &in : robotNodes)
+        in.local = inner_eigen->get_transformation_matrix(robot_name, in.name).value();
+    compute_robot_bounds();
     //    std::cout << __FUNCTION__ << "RESTNODES" << std::endl;
     //    for(auto n : restNodes)
     //        std::cout << n << std::endl;
@@ -37,152 +47,490 @@ void Collisions::initialize(const std::shared_ptr<DSR::DSRGraph> &graph_,const s
     qsrand( QTime::currentTime().msec() );
 }
 
-std::tuple<bool, std::string> Collisions::checkRobotValidStateAtTargetFast(DSR::DSRGraph& G_copy, const std::vector<float> &targetPos, const std::vector<float> &targetRot)
+std::tuple<bool, std::string> Collisions::checkRobotValidStateAtTarget(const std::vector<float> &targetPos, const std::vector<float> &targetRot)
 {
-    //First we move the robot in G_copy to the target coordinates
-    std::optional<Node> world = G_copy.get_node(world_name);
-    std::optional<int> robot_id = G_copy.get_id_from_name(robot_name);
-    std::unique_ptr<RT_API> rt = G_copy.get_rt_api();
-    rt->insert_or_assign_edge_RT(world.value(), robot_id.value(), targetPos, targetRot);
-    std::shared_ptr<DSR::InnerEigenAPI> inner_eigen = G_copy.get_inner_eigen_api();
+    const Mat::RTMat world_robot = robot_pose(targetPos, targetRot);
+    // upright poses far from every world mesh are answered by the footprint layer
+    if (targetRot[0] == 0 and targetRot[1] == 0 and footprint_is_clear(targetPos[0], targetPos[1], targetPos[2]))
+    {
+        footprint_answers++;
+        return std::make_tuple(true, "");
+    }
+    for ( const auto &in : robotNodes )
+        set_pose(in.object, world_robot * in.local);
+    return check_robot_against_world();
+}
 
-    //// Check if the robot at the target collides with any object in restNodes
-    bool collision = false;
-    for ( const std::string& in : robotNodes )
-        for ( const std::string&  out : restNodes )
+// same composition InnerEigenAPI uses for an RT edge: translation, then rotations about X, Y and Z
+Mat::RTMat Collisions::robot_pose(const std::vector<float> &targetPos, const std::vector<float> &targetRot) const
+{
+    return Mat::RTMat(Eigen::Translation3d(targetPos[0], targetPos[1], targetPos[2]) *
+                      Eigen::AngleAxisd(targetRot[0], Eigen::Vector3d::UnitX()) *
+                      Eigen::AngleAxisd(targetRot[1], Eigen::Vector3d::UnitY()) *
+                      Eigen::AngleAxisd(targetRot[2], Eigen::Vector3d::UnitZ()));
+}
+
+/**
+ @brief Conservative advancement along the segment. With a pure translation every robot point moves as far as the
+ robot origin, so the robot can advance by its current clearance to the world without touching anything. It stops
+ when the target is reached or the robot touches the world, the same contact checkRobotValidStateAtTarget rejects.
+ Grazing a wall, the clearance and so the steps become tiny. Once a step would be shorter than min_step, or after
+ max_iterations, the rest of the segment is checked with discrete poses min_step apart instead.
+*/
+std::tuple<bool, std::string> Collisions::checkRobotValidSegment(const std::vector<float> &sourcePos, const std::vector<float> &targetPos, const std::vector<float> &targetRot)
+{
+    const float min_step = 10.f;
+    const int max_iterations = 100;
+    const Eigen::Vector3d source(sourcePos[0], sourcePos[1], sourcePos[2]);
+    const Eigen::Vector3d target(targetPos[0], targetPos[1], targetPos[2]);
+    const double length = (target - source).norm();
+    auto point_at = [&](double travelled)
+    {
+        const Eigen::Vector3d p = length > 0 ? Eigen::Vector3d(source + (target - source) * (travelled / length)) : source;
+        return std::vector<float>{(float)p.x(), (float)p.y(), (float)p.z()};
+    };
+    double travelled = 0;
+    for (int iteration = 0; iteration < max_iterations; iteration++)
+    {
+        const Mat::RTMat world_robot = robot_pose(point_at(travelled), targetRot);
+        DistanceData data;
+        for ( const auto &in : robotNodes )
         {
-            try
-            {
-                collision = collide(inner_eigen, in, out);
-            }
-            catch (QString &s)
-            {
-                std::cout << __FUNCTION__ << " " << s.toStdString() << " between " << in << " and " << out << std::endl;
-                qFatal("Collision");
-            }
-            if (collision)
-            {
-                std::cout << "COLLISION: " << in << " to " << out << " pos: (" << targetPos[0] << "," << targetPos[1]
-                          << "," << targetPos[2] << ")" << std::endl;
-                return std::make_tuple(false, out);
-            }
+            set_pose(in.object, world_robot * in.local);
+            world_manager->distance(in.object, &data, distance_callback);
         }
-    return std::make_tuple(true, "");;
+        narrow_phase_calls += data.calls;
+        if (data.closest == nullptr)   // no world meshes
+            return std::make_tuple(true, "");
+        if (data.min_distance <= 0)
+            return std::make_tuple(false, data.closest->name);
+        if (travelled >= length)
+            return std::make_tuple(true, "");
+        if (data.min_distance < min_step)
+            break;
+        travelled = std::min(length, travelled + data.min_distance);
+    }
+    // sampled fallback, which can only miss an obstacle thinner than min_step
+    const int samples = std::ceil((length - travelled) / min_step);
+    for (int k = 1; k <= samples; k++)
+        if (const auto &[free, name] = checkRobotValidStateAtTarget(point_at(travelled + (length - travelled) * k / samples), targetRot); not free)
+            return std::make_tuple(false, name);
+    return std::make_tuple(true, "");
 }
 
-bool Collisions::collide(std::shared_ptr<DSR::InnerEigenAPI> inner_eigen, const std::string &node_a_name, const std::string &node_b_name)
+// keeps the smallest robot-world distance. dist is the current bound the broad phase uses to prune
+bool Collisions::distance_callback(fcl::CollisionObject *o1, fcl::CollisionObject *o2, void *data, fcl::FCL_REAL &dist)
 {
-    //std::cout << "collide " << node_a_name << " to "<< node_b_name << std::endl;
-    Mat::RTMat r1q = inner_eigen->get_transformation_matrix(world_name, node_a_name).value();
-    fcl::Matrix3f R1( r1q(0,0), r1q(0,1), r1q(0,2), r1q(1,0), r1q(1,1), r1q(1,2), r1q(2,0), r1q(2,1), r1q(2,2) );
-    fcl::Vec3f T1( r1q(0,3), r1q(1,3), r1q(2,3) );
-    Mat::RTMat r2q = inner_eigen->get_transformation_matrix(world_name, node_b_name).value();
-    fcl::Matrix3f R2( r2q(0,0), r2q(0,1), r2q(0,2), r2q(1,0), r2q(1,1), r2q(1,2), r2q(2,0), r2q(2,1), r2q(2,2) );
-    fcl::Vec3f T2( r2q(0,3), r2q(1,3), r2q(2,3) );
+    auto query = static_cast<DistanceData *>(data);
+    query->calls++;
+    fcl::DistanceResult result;
+    const float d = std::max<fcl::FCL_REAL>(0, fcl::distance(o1, o2, query->request, result));
+    if (d < query->min_distance)
+    {
+        query->min_distance = d;
+        auto world_object = o1->getUserData() != nullptr ? o1 : o2;
+        query->closest = static_cast<const MeshNode *>(world_object->getUserData());
+    }
+    dist = query->min_distance;
+    return dist <= 0;
+}
 
-    fcl::CollisionRequest request;
-    fcl::CollisionResult result;
-    fcl::CollisionObject* n1 = get_collision_object(node_a_name);
-    fcl::CollisionObject* n2 = get_collision_object(node_b_name);
+void Collisions::compute_robot_bounds()
+{
+    robot_radius = 0;
+    robot_zmin = std::numeric_limits<float>::max();
+    robot_zmax = std::numeric_limits<float>::lowest();
+    for (const auto &in : robotNodes)
+    {
+        const fcl::AABB &box = in.object->collisionGeometry()->aabb_local;
+        for (int corner = 0; corner < 8; corner++)
+        {
+            const Eigen::Vector3d p = in.local * Eigen::Vector3d(corner & 1 ? box.max_[0] : box.min_[0],
+                                                                 corner & 2 ? box.max_[1] : box.min_[1],
+                                                                 corner & 4 ? box.max_[2] : box.min_[2]);
+            robot_radius = std::max(robot_radius, (float)std::hypot(p.x(), p.y()));
+            robot_zmin = std::min(robot_zmin, (float)p.z());
+            robot_zmax = std::max(robot_zmax, (float)p.z());
+        }
+    }
+}
 
-    if (n1 != nullptr and n2 != nullptr)
+// world boxes are the 8 corners of each mesh local AABB placed at its world pose. getAABB() is no use here, as for a
+// rotated mesh FCL returns the cube around the sphere of its local box, far larger than a thin rotated wall
+void Collisions::build_footprint(float z)
+{
+    footprint = FootprintLayer();
+    footprint.z = z;
+    std::vector<fcl::AABB> boxes;
+    for (const auto &out : restNodes)
+    {
+        const fcl::AABB &local = out.object->collisionGeometry()->aabb_local;
+        const fcl::Transform3f &pose = out.object->getTransform();
+        fcl::AABB box(pose.transform(local.min_));
+        for (int corner = 1; corner < 8; corner++)
+        {
+            const fcl::Vec3f p = pose.transform(fcl::Vec3f(corner & 1 ? local.max_[0] : local.min_[0],
+                                                           corner & 2 ? local.max_[1] : local.min_[1],
+                                                           corner & 4 ? local.max_[2] : local.min_[2]));
+            box += p;
+        }
+        if (box.max_[2] >= z + robot_zmin and box.min_[2] <= z + robot_zmax)
+            boxes.push_back(box);
+    }
+    if (boxes.empty())
+        return;
+    float x1 = std::numeric_limits<float>::lowest(), y1 = std::numeric_limits<float>::lowest();
+    footprint.x0 = footprint.y0 = std::numeric_limits<float>::max();
+    for (const auto &box : boxes)
     {
-        n1->setTransform(R1, T1);
-        n1->computeAABB();
-        n2->setTransform(R2, T2);
-        n2->computeAABB();
-        fcl::collide(n1, n2, request, result);
-        return result.isCollision();
+        footprint.x0 = std::min(footprint.x0, (float)box.min_[0] - robot_radius);
+        footprint.y0 = std::min(footprint.y0, (float)box.min_[1] - robot_radius);
+        x1 = std::max(x1, (float)box.max_[0] + robot_radius);
+        y1 = std::max(y1, (float)box.max_[1] + robot_radius);
     }
-    else
+    // coarser cells for very large scenes, so the layer stays below a few million cells
+    footprint.cell = std::max(footprint.cell, std::sqrt((x1 - footprint.x0) * (y1 - footprint.y0) / 4e6f));
+    footprint.cols = std::ceil((x1 - footprint.x0) / footprint.cell) + 1;
+    footprint.rows = std::ceil((y1 - footprint.y0) / footprint.cell) + 1;
+    footprint.blocked.assign(footprint.cols * footprint.rows, false);
+    for (const auto &box : boxes)
+    {
+        const long int c0 = (box.min_[0] - robot_radius - footprint.x0) / footprint.cell;
+        const long int c1 = (box.max_[0] + robot_radius - footprint.x0) / footprint.cell;
+        const long int r0 = (box.min_[1] - robot_radius - footprint.y0) / footprint.cell;
+        const long int r1 = (box.max_[1] + robot_radius - footprint.y0) / footprint.cell;
+        for (long int r = r0; r <= r1; r++)
+            for (long int c = c0; c <= c1; c++)
+                footprint.blocked[r * footprint.cols + c] = true;
+    }
+}
+
+bool Collisions::footprint_is_clear(float x, float y, float z)
+{
+    if (robotNodes.empty())
         return false;
+    if (footprint.z != z)
+        build_footprint(z);
+    if (footprint.blocked.empty())
+        return true;
+    const long int c = std::floor((x - footprint.x0) / footprint.cell);
+    const long int r = std::floor((y - footprint.y0) / footprint.cell);
+    if (c < 0 or c >= footprint.cols or r < 0 or r >= footprint.rows)
+        return true;
+    return not footprint.blocked[r * footprint.cols + c];
 }
 
-void Collisions::recursiveIncludeMeshes(Node node, std::string robot_name, bool inside, std::vector<std::string> &in, std::vector<std::string> &out, std::set<std::string> &excluded)
+// Checks the robot meshes, already placed, against the world meshes in the broad phase
+std::tuple<bool, std::string> Collisions::check_robot_against_world()
 {
-    if (node.name() == robot_name)
-        inside = true;
-    if (node.type() == "mesh" or node.type() == "plane")
+    for ( const auto &in : robotNodes )
     {
-        if (std::find(excluded.begin(), excluded.end(), node.name()) == excluded.end())
+        QueryData data;
+        try
+        {
+            world_manager->collide(in.object, &data, broadphase_callback);
+        }
+        catch (QString &s)
         {
-            if (inside)
-                in.push_back(node.name());
-            else
-                out.push_back(node.name());
+            std::cout << __FUNCTION__ << " " << s.toStdString() << " between " << in.name << " and the world" << std::endl;
+            qFatal("Collision");
         }
+        narrow_phase_calls += data.calls;
+        if (data.hit != nullptr)
+            return std::make_tuple(false, data.hit->name);
     }
-    for(auto &edge: G->get_node_edges_by_type(node, "RT"))
+    return std::make_tuple(true, "");;
+}
+
+// narrow phase for a pair whose AABBs overlap. Returning true stops the broad phase traversal
+bool Collisions::broadphase_callback(fcl::CollisionObject *o1, fcl::CollisionObject *o2, void *data)
+{
+    auto query = static_cast<QueryData *>(data);
+    query->calls++;
+    fcl::collide(o1, o2, query->request, query->result);
+    if (query->result.isCollision())
     {
-        auto child = G->get_node(edge.to());
-        recursiveIncludeMeshes(child.value(), robot_name, inside, in, out, excluded);
+        auto world_object = o1->getUserData() != nullptr ? o1 : o2;
+        query->hit = static_cast<const MeshNode *>(world_object->getUserData());
+        return true;
     }
+    return false;
 }
 
-//returns collison object, creates it if does not exist
-fcl::CollisionObject* Collisions::get_collision_object(const std::string& node_name)
+void Collisions::build_world_manager()
+{
+    world_manager = std::make_shared<fcl::DynamicAABBTreeCollisionManager>();
+    std::vector<fcl::CollisionObject*> objects;
+    for (auto &out : restNodes)
+    {
+        out.object->setUserData(&out);
+        objects.push_back(out.object);
+    }
+    world_manager->registerObjects(objects);
+    world_manager->setup();
+}
+
+void Collisions::update_world_meshes_below(std::uint32_t id, const std::shared_ptr<DSR::InnerEigenAPI> &inner_eigen)
 {
-    if (collision_objects.find(node_name) == collision_objects.end())
+    const auto it = world_meshes_below.find(id);
+    if (it == world_meshes_below.end())
+        return;
+    for (const auto i : it->second)
     {
-        // object creation
-        std::optional<Node> node = G->get_node(node_name);
-        if (node.has_value())
+        place(inner_eigen, restNodes[i]);
+        world_manager->update(restNodes[i].object);
+    }
+    footprint = FootprintLayer();
+}
+
+// every world mesh is listed under itself and each of its ancestors, up to the root
+void Collisions::index_world_meshes()
+{
+    world_meshes_below.clear();
+    for (std::size_t i = 0; i < restNodes.size(); i++)
+        for (auto node = G->get_node(restNodes[i].id); node.has_value(); node = G->get_parent_node(node.value()))
+            world_meshes_below[node->id()].push_back(i);
+}
+
+std::shared_ptr<Collisions> Collisions::clone() const
+{
+    auto copy = std::make_shared<Collisions>(*this);
+    for (auto &[id, object] : copy->collision_objects)
+        if (object != nullptr)
+            object = std::make_shared<fcl::CollisionObject>(std::const_pointer_cast<fcl::CollisionGeometry>(object->collisionGeometry()),
+                                                            object->getTransform());
+    for (auto &node : copy->robotNodes)
+        node.object = copy->collision_objects.at(node.id).get();
+    for (auto &node : copy->restNodes)
+        node.object = copy->collision_objects.at(node.id).get();
+    copy->build_world_manager();
+    return copy;
+}
+
+void Collisions::place(const std::shared_ptr<DSR::InnerEigenAPI> &inner_eigen, const MeshNode &node)
+{
+    set_pose(node.object, inner_eigen->get_transformation_matrix(world_name, node.name).value());
+}
+
+void Collisions::set_pose(fcl::CollisionObject *object, const Mat::RTMat &rq)
+{
+    fcl::Matrix3f R( rq(0,0), rq(0,1), rq(0,2), rq(1,0), rq(1,1), rq(1,2), rq(2,0), rq(2,1), rq(2,2) );
+    fcl::Vec3f T( rq(0,3), rq(1,3), rq(2,3) );
+    object->setTransform(R, T);
+    object->computeAABB();
+}
+
+void Collisions::recursiveIncludeMeshes(const Node &node, const std::string &robot_name, bool inside, std::vector<MeshNode> &in, std::vector<MeshNode> &out, const std::set<std::string> &excluded)
+{
+    if (node.name() == robot_name)
+        inside = true;
+    if (node.type() == mesh_type or node.type() == plane_type)
+    {
+        if (excluded.find(node.name()) == excluded.end())
         {
-            if( node.value().type() == "plane" )
-                collision_objects[node_name] = create_plane_collision_object(node.value());
-            else
+            // nodes without a valid collision object could never collide, so they are left out of the lists
+            if (auto object = get_collision_object(node); object != nullptr)
             {
-                if( node.value().type() == "mesh")
-                    collision_objects[node_name] = create_mesh_collision_object(node.value());
+                if (inside)
+                    in.push_back(MeshNode{node.id(), node.name(), object});
                 else
-                    collision_objects[node_name] = nullptr;
+                    out.push_back(MeshNode{node.id(), node.name(), object});
             }
         }
     }
-    return collision_objects[node_name];
+    for(auto &edge: G->get_node_edges_by_type(node, rt_type))
+    {
+        auto child = G->get_node(edge.to());
+        recursiveIncludeMeshes(child.value(), robot_name, inside, in, out, excluded);
+    }
+}
+
+//returns collison object, creates it if does not exist
+fcl::CollisionObject* Collisions::get_collision_object(const Node &node)
+{
+    if (auto it = collision_objects.find(node.id()); it != collision_objects.end())
+        return it->second.get();
+    // object creation
+    std::shared_ptr<fcl::CollisionObject> object;
+    if( node.type() == plane_type )
+        object = create_plane_collision_object(node);
+    else if( node.type() == mesh_type)
+        object = create_mesh_collision_object(node);
+    collision_objects[node.id()] = object;
+    return object.get();
 }
 
-fcl::CollisionObject* Collisions::create_mesh_collision_object(const Node &node)
+std::shared_ptr<fcl::CollisionObject> Collisions::create_mesh_collision_object(const Node &node)
 {
-    fcl::CollisionObject* collision_object = nullptr;
+    std::shared_ptr<fcl::CollisionObject> collision_object;
     std::optional<std::string> meshPath = G->get_attrib_by_name<path_att>(node);
-    osg::ref_ptr<osg::Node> osgnode_ = osgDB::readNodeFile(meshPath.value());
-    if (osgnode_ != NULL)
+    std::optional<int> scalex = G->get_attrib_by_name<scalex_att>(node);
+    std::optional<int> scaley = G->get_attrib_by_name<scaley_att>(node);
+    std::optional<int> scalez = G->get_attrib_by_name<scalez_att>(node);
+    if(not (scalex.has_value() and scaley.has_value() and scalez.has_value()))
+    {
+        qWarning() << __FUNCTION__ << "scale attributes not found in object " << QString::fromStdString(node.name()) << " returning nullptr";
+        return collision_object;
+    }
+
+    std::vector<fcl::Vec3f> vertices;
+    std::vector<fcl::Triangle> triangles;
+    const auto cache_file = mesh_cache_file(meshPath.value(), scalex.value(), scaley.value(), scalez.value());
+    if (not (cache_file.has_value() and read_cached_mesh(cache_file.value(), scalex.value(), scaley.value(), scalez.value(), vertices, triangles)))
     {
-        std::vector<fcl::Vec3f> vertices;
-        std::vector<fcl::Triangle> triangles;
+        osg::ref_ptr<osg::Node> osgnode_ = osgDB::readNodeFile(meshPath.value());
+        if (osgnode_ == NULL)
+            return collision_object;
         CalculateTriangles calcTriangles(&vertices, &triangles);
         osgnode_->accept(calcTriangles);
 
         // Transform each of the read vertices
-        std::optional<int> scalex = G->get_attrib_by_name<scalex_att>(node);
-        std::optional<int> scaley = G->get_attrib_by_name<scaley_att>(node);
-        std::optional<int> scalez = G->get_attrib_by_name<scalez_att>(node);
-        if(not (scalex.has_value() and scaley.has_value() and scalez.has_value()))
-        {
-            qWarning() << __FUNCTION__ << "scale attributes not found in object " << QString::fromStdString(node.name()) << " returning nullptr";
-            return collision_object;
-        }
         for(auto &v : vertices)
         {
             v[0] *= scalex.value();
             v[1] *= scaley.value();
             v[2] *= -scalez.value();
         }
-
-        // Associate the vertices and triangles vectors to the FCL collision model object
-        FCLModelPtr fclMesh = FCLModelPtr(new FCLModel());
-        fclMesh->beginModel();
-            fclMesh->addSubModel(vertices, triangles);
-        fclMesh->endModel();
-        collision_object = new fcl::CollisionObject(fclMesh);
+        if (cache_file.has_value())
+            write_cached_mesh(cache_file.value(), scalex.value(), scaley.value(), scalez.value(), vertices, triangles);
     }
+
+    // Associate the vertices and triangles vectors to the FCL collision model object
+    FCLModelPtr fclMesh = FCLModelPtr(new FCLModel());
+    fclMesh->beginModel();
+        fclMesh->addSubModel(vertices, triangles);
+    fclMesh->endModel();
+    collision_object = std::make_shared<fcl::CollisionObject>(fclMesh);
     return collision_object;
 }
 
-fcl::CollisionObject* Collisions::create_plane_collision_object(const Node &node)
+// Cache file for a mesh at a given scale, named after a hash of the mesh file contents, so it changes when the mesh does.
+// Hashing reads the whole mesh, so the name is also kept in a stamp file keyed by path, size, modification time and
+// scales, and the contents are only hashed again when one of those changes
+std::optional<std::string> Collisions::mesh_cache_file(const std::string &mesh_path, int scalex, int scaley, int scalez) const
+{
+    if (bvh_cache_dir.empty())
+        return {};
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(mesh_path, ec);
+    if (ec)
+        return {};
+    const auto mtime = std::filesystem::last_write_time(mesh_path, ec);
+    if (ec)
+        return {};
+    const std::string scales = " " + std::to_string(scalex) + " " + std::to_string(scaley) + " " + std::to_string(scalez);
+    const std::string stamp = mesh_path + " " + std::to_string(size) + " " + std::to_string(mtime.time_since_epoch().count()) + scales;
+    const auto dir = std::filesystem::path(bvh_cache_dir);
+    const auto stamp_file = dir / (fnv1a_hex(stamp) + ".stamp");
+    {
+        // first line is the whole stamp, so a hash collision is not taken as a hit
+        std::ifstream in(stamp_file);
+        std::string stored_stamp, name;
+        if (std::getline(in, stored_stamp) and stored_stamp == stamp and std::getline(in, name) and not name.empty())
+            return (dir / name).string();
+    }
+    std::ifstream mesh(mesh_path, std::ios::binary);
+    if (not mesh)
+        return {};
+    const std::string content((std::istreambuf_iterator<char>(mesh)), std::istreambuf_iterator<char>());
+    const std::string name = fnv1a_hex(content + mesh_path + scales) + ".mesh";
+    std::filesystem::create_directories(dir, ec);
+    const std::string tmp = stamp_file.string() + "." + std::to_string(::getpid());
+    if (std::ofstream out(tmp); out << stamp << "\n" << name << "\n")
+    {
+        out.close();
+        std::filesystem::rename(tmp, stamp_file, ec);
+    }
+    else
+        std::filesystem::remove(tmp, ec);
+    return (dir / name).string();
+}
+
+// FNV-1a, stable across processes and builds
+std::string Collisions::fnv1a_hex(const std::string &key)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : key)
+    {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    std::stringstream name;
+    name << std::hex << hash;
+    return name.str();
+}
+
+// the header must match the requested scales and the counts the file size, and every index a vertex. Any mismatch
+// is reported as a miss, so the mesh is read again and the file rewritten
+bool Collisions::read_cached_mesh(const std::string &file, int scalex, int scaley, int scalez, std::vector<fcl::Vec3f> &vertices, std::vector<fcl::Triangle> &triangles) const
+{
+    std::ifstream in(file, std::ios::binary | std::ios::ate);
+    if (not in)
+        return false;
+    const std::uint64_t file_size = in.tellg();
+    in.seekg(0);
+    MeshCacheHeader header;
+    if (file_size < sizeof(header) or not in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+    const MeshCacheHeader expected;
+    if (std::memcmp(header.magic, expected.magic, sizeof(expected.magic)) != 0 or header.version != expected.version or
+        header.scale[0] != scalex or header.scale[1] != scaley or header.scale[2] != scalez)
+        return false;
+    const std::uint64_t n_vertices = header.n_vertices, n_triangles = header.n_triangles;
+    if (n_vertices > file_size or n_triangles > file_size or
+        file_size != sizeof(header) + 3 * n_vertices * sizeof(double) + 3 * n_triangles * sizeof(std::uint32_t))
+        return false;
+    std::vector<double> coords(3 * n_vertices);
+    std::vector<std::uint32_t> indices(3 * n_triangles);
+    if (not in.read(reinterpret_cast<char*>(coords.data()), coords.size() * sizeof(double)) or
+        not in.read(reinterpret_cast<char*>(indices.data()), indices.size() * sizeof(std::uint32_t)))
+        return false;
+    if (std::any_of(indices.begin(), indices.end(), [n_vertices](std::uint32_t i) { return i >= n_vertices; }))
+        return false;
+    vertices.clear(); triangles.clear();
+    vertices.reserve(n_vertices); triangles.reserve(n_triangles);
+    for (std::size_t i = 0; i < n_vertices; i++)
+        vertices.emplace_back(coords[3*i], coords[3*i+1], coords[3*i+2]);
+    for (std::size_t i = 0; i < n_triangles; i++)
+        triangles.emplace_back(indices[3*i], indices[3*i+1], indices[3*i+2]);
+    return true;
+}
+
+// written to a temporary name and renamed, so agents starting at the same time never read a partial file
+void Collisions::write_cached_mesh(const std::string &file, int scalex, int scaley, int scalez, const std::vector<fcl::Vec3f> &vertices, const std::vector<fcl::Triangle> &triangles) const
+{
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(file).parent_path(), ec);
+    const std::string tmp = file + "." + std::to_string(::getpid());
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        MeshCacheHeader header;
+        header.scale[0] = scalex; header.scale[1] = scaley; header.scale[2] = scalez;
+        header.n_vertices = vertices.size();
+        header.n_triangles = triangles.size();
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto &v : vertices)
+        {
+            const double c[3] = {v[0], v[1], v[2]};
+            out.write(reinterpret_cast<const char*>(c), sizeof(c));
+        }
+        for (const auto &t : triangles)
+        {
+            const std::uint32_t c[3] = {(std::uint32_t)t[0], (std::uint32_t)t[1], (std::uint32_t)t[2]};
+            out.write(reinterpret_cast<const char*>(c), sizeof(c));
+        }
+        if (not out)
+        {
+            std::filesystem::remove(tmp, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tmp, file, ec);
+}
+
+std::shared_ptr<fcl::CollisionObject> Collisions::create_plane_collision_object(const Node &node)
 {
-    fcl::CollisionObject* collision_object = nullptr;
+    std::shared_ptr<fcl::CollisionObject> collision_object;
     std::optional<int> width = G->get_attrib_by_name<width_att>(node);
     std::optional<int> height = G->get_attrib_by_name<height_att>(node);
     std::optional<int> depth = G->get_attrib_by_name<depth_att>(node);
@@ -219,6 +567,6 @@ fcl::CollisionObject* Collisions::create_plane_collision_object(const Node &node
     fclMesh->beginModel();
         fclMesh->addSubModel(vertices, triangles);
     fclMesh->endModel();
-    collision_object = new fcl::CollisionObject(fclMesh);
+    collision_object = std::make_shared<fcl::CollisionObject>(fclMesh);
     return collision_object;
 }
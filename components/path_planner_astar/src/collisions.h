@@ -19,12 +19,18 @@
 #include <fcl/traversal/traversal_node_setup.h>
 #include <fcl/traversal/traversal_node_bvh_shape.h>
 #include <fcl/traversal/traversal_node_bvhs.h>
+#include <fcl/broadphase/broadphase_dynamic_AABB_tree.h>
 #include <osg/TriangleFunctor>
 #include <osg/io_utils>
 #include <osg/Geode>
 #include <osgDB/FileUtils>
 #include <osgDB/ReadFile>
 #include <osg/MatrixTransform>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <unistd.h>
+#include "../../../etc/viriato_graph_names.h"
 
 typedef fcl::BVHModel<fcl::OBBRSS> FCLModel;
 typedef std::shared_ptr<FCLModel> FCLModelPtr;
@@ -129,27 +135,106 @@ class Collisions
 {
     public:
         void initialize(const std::shared_ptr<DSR::DSRGraph> &graph_, const std::shared_ptr< RoboCompCommonBehavior::ParameterList > &params_);
-        std::tuple<bool, std::string> checkRobotValidStateAtTargetFast(DSR::DSRGraph &G_copy, const std::vector<float> &targetPos, const std::vector<float> &targetRot);
+        // checks the robot at a hypothetical world->robot RT, composed with the robot meshes' cached local poses. G is not touched
+        std::tuple<bool, std::string> checkRobotValidStateAtTarget(const std::vector<float> &targetPos, const std::vector<float> &targetRot);
+        // continuous check of the robot translating from sourcePos to targetPos with a fixed rotation, so thin
+        // obstacles between two valid poses are not missed. Near a wall it falls back to poses 10 mm apart
+        std::tuple<bool, std::string> checkRobotValidSegment(const std::vector<float> &sourcePos, const std::vector<float> &targetPos, const std::vector<float> &targetRot);
+        // copy with its own collision objects sharing the same geometry, to run checks from another thread.
+        // Creating an object recomputes the AABB of its geometry, so clones must be made before any check runs
+        std::shared_ptr<Collisions> clone() const;
+        // world meshes are placed once and kept in the broad phase. This re-places those at or below node id, for
+        // when the RT edge to it changes. Ids with no world mesh below, such as the robot's, cost one lookup
+        void update_world_meshes_below(std::uint32_t id, const std::shared_ptr<DSR::InnerEigenAPI> &inner_eigen);
+        // FCL narrow phase calls made by the checks of this object so far, and poses answered by the footprint layer
+        // without calling FCL, to measure the footprint layer on a real sweep
+        std::size_t get_narrow_phase_calls() const { return narrow_phase_calls; };
+        std::size_t get_footprint_answers() const { return footprint_answers; };
         QRectF outerRegion;
 
     private:
+        // mesh or plane node resolved once, so the collision loop does no lookups by name
+        struct MeshNode
+        {
+            std::uint32_t id;
+            std::string name;
+            fcl::CollisionObject *object;
+            Mat::RTMat local;   // robot meshes only, pose in the robot frame
+        };
         std::shared_ptr<DSR::DSRGraph> G;
-        std::map<std::string, fcl::CollisionObject*> collision_objects;
-        std::vector<std::string> robotNodes;
-        std::vector<std::string> restNodes;
+        // owns the objects, MeshNode::object points into it. Clones own copies sharing the same geometry
+        std::unordered_map<std::uint32_t, std::shared_ptr<fcl::CollisionObject>> collision_objects;
+        std::vector<MeshNode> robotNodes;
+        std::vector<MeshNode> restNodes;
         std::set<std::string> excludedNodes;
+        // AABB tree over the restNodes objects. Their user data points to the MeshNode
+        std::shared_ptr<fcl::BroadPhaseCollisionManager> world_manager;
+        // node id -> indices in restNodes of the world meshes at or below it in the RT tree
+        std::unordered_map<std::uint32_t, std::vector<std::size_t>> world_meshes_below;
+        void index_world_meshes();
+        std::size_t narrow_phase_calls = 0, footprint_answers = 0;
+        struct QueryData
+        {
+            fcl::CollisionRequest request;
+            fcl::CollisionResult result;
+            const MeshNode *hit = nullptr;
+            std::size_t calls = 0;
+        };
+        static bool broadphase_callback(fcl::CollisionObject *o1, fcl::CollisionObject *o2, void *data);
+        struct DistanceData
+        {
+            fcl::DistanceRequest request;
+            float min_distance = std::numeric_limits<float>::max();
+            const MeshNode *closest = nullptr;
+            std::size_t calls = 0;
+        };
+        static bool distance_callback(fcl::CollisionObject *o1, fcl::CollisionObject *o2, void *data, fcl::FCL_REAL &dist);
+        Mat::RTMat robot_pose(const std::vector<float> &targetPos, const std::vector<float> &targetRot) const;
+
+        // Floor-plane layer of cells the robot could touch a world mesh from, whatever its heading: the world boxes
+        // overlapping the robot height, grown by the robot radius. Poses outside it are free without calling FCL
+        struct FootprintLayer
+        {
+            float z = std::numeric_limits<float>::quiet_NaN();   // robot height the layer was built for
+            float x0 = 0, y0 = 0, cell = 50;
+            long int cols = 0, rows = 0;
+            std::vector<bool> blocked;
+        };
+        FootprintLayer footprint;
+        float robot_radius = 0, robot_zmin = 0, robot_zmax = 0;   // robot meshes bounds in the robot frame
+        void compute_robot_bounds();
+        void build_footprint(float z);
+        bool footprint_is_clear(float x, float y, float z);
 
         // node names
         std::string robot_name = "omnirobot";
         std::string world_name = "world";
 
-
-        void recursiveIncludeMeshes(Node node, std::string robot_name, bool inside, std::vector<std::string> &in, std::vector<std::string> &out, std::set<std::string> &excluded);
-        bool collide(std::shared_ptr<DSR::InnerEigenAPI> inner_eigen, const std::string &node_a_name, const std::string &node_b_name);
+        void recursiveIncludeMeshes(const Node &node, const std::string &robot_name, bool inside, std::vector<MeshNode> &in, std::vector<MeshNode> &out, const std::set<std::string> &excluded);
+        // sets the object of node at its world pose in inner_eigen
+        void place(const std::shared_ptr<DSR::InnerEigenAPI> &inner_eigen, const MeshNode &node);
+        static void set_pose(fcl::CollisionObject *object, const Mat::RTMat &pose);
+        std::tuple<bool, std::string> check_robot_against_world();
+        void build_world_manager();
         // returns collison object, creates it if does not exist
-        fcl::CollisionObject* get_collision_object(const std::string& node_name);
-        fcl::CollisionObject* create_mesh_collision_object(const Node &node);
-        fcl::CollisionObject* create_plane_collision_object(const Node &node);
+        fcl::CollisionObject* get_collision_object(const Node &node);
+        std::shared_ptr<fcl::CollisionObject> create_mesh_collision_object(const Node &node);
+        // scaled mesh triangles cached on disk, shared by all agents on the machine. Empty dir disables it
+        std::string bvh_cache_dir;
+        // file layout: this header, 3 doubles per vertex and 3 uint32 vertex indices per triangle
+        struct MeshCacheHeader
+        {
+            char magic[8] = {'D', 'S', 'R', 'M', 'E', 'S', 'H', '\0'};
+            std::uint32_t version = 1;
+            std::int32_t scale[3] = {0, 0, 0};
+            std::uint64_t n_vertices = 0;
+            std::uint64_t n_triangles = 0;
+        };
+        std::optional<std::string> mesh_cache_file(const std::string &mesh_path, int scalex, int scaley, int scalez) const;
+        static std::string fnv1a_hex(const std::string &key);
+        bool read_cached_mesh(const std::string &file, int scalex, int scaley, int scalez, std::vector<fcl::Vec3f> &vertices, std::vector<fcl::Triangle> &triangles) const;
+        void write_cached_mesh(const std::string &file, int scalex, int scaley, int scalez, const std::vector<fcl::Vec3f> &vertices, const std::vector<fcl::Triangle> &triangles) const;
+        std::shared_ptr<fcl::CollisionObject> create_plane_collision_object(const Node &node);
 };
 
 #endif //COLLISIONS_H
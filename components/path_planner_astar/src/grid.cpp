@@ -11,11 +11,16 @@ void Grid<T>::initialize(const std::shared_ptr<DSR::DSRGraph> &graph_,
 {
     qDebug() << __FUNCTION__ << "FileName:" << QString::fromStdString(file_name);
     G = graph_;
-    uint count = 0;
     dim = dim_;
     qInfo() << __FUNCTION__ << dim.HMIN << dim.WIDTH << dim.VMIN << dim.HEIGHT;
-    fmap.clear();
+    cols = std::ceil(dim.WIDTH / dim.TILE_SIZE);
+    rows = std::ceil(dim.HEIGHT / dim.TILE_SIZE);
+    // cells not set by the file or the sweep below are left as occupied
+    fmap.resize(cols * rows);
+    for (std::size_t i = 0; i < fmap.size(); i++)
+        fmap[i] = T{static_cast<std::uint32_t>(i), false, false, 1.f, 0};
     fmap_aux.clear();
+    components_dirty = distances_dirty = true;
 
     if(read_from_file and not file_name.empty())
     {
@@ -24,20 +29,50 @@ void Grid<T>::initialize(const std::shared_ptr<DSR::DSRGraph> &graph_,
     }
     else
     {
-        std::cout << __FUNCTION__ << "Collisions - checkRobotValidStateAtTargetFast" << std::endl;
-        auto G_copy = G->G_copy();
-        for (int i = dim.HMIN; i < dim.HMIN + dim.WIDTH; i += dim.TILE_SIZE)
+        // Columns are handed out to a pool of threads. Each one places the robot at every candidate pose
+        // in its own FCL objects without writing to G, so the only shared state is the column counter
+        const unsigned int n_threads = std::max(1u, std::thread::hardware_concurrency());
+        std::cout << __FUNCTION__ << "Collisions - checkRobotValidStateAtTarget with " << n_threads << " threads" << std::endl;
+        std::vector<std::tuple<bool, std::string>> results(fmap.size());
+        std::atomic<std::size_t> next_column = 0, done_columns = 0;
+        std::mutex progress_mutex;
+        const auto start = std::chrono::steady_clock::now();
+        auto sweep = [&](std::shared_ptr<Collisions> collisions)
         {
-            for (int j = dim.VMIN; j < dim.VMIN + dim.HEIGHT; j += dim.TILE_SIZE)
+            for (std::size_t c = next_column++; c < cols; c = next_column++)
             {
-                auto[free, node_name] = collisions_->checkRobotValidStateAtTargetFast(G_copy,
-                                                                                      std::vector<float>{(float) i,
-                                                                                                         (float) j, 10},
-                                                                                      std::vector<float>{0.0, 0.0,
-                                                                                                         0.0});
-                fmap.emplace(Key(i, j), T{count++, free, true, 1.f, node_name});
+                const int i = dim.HMIN + c * dim.TILE_SIZE;
+                for (int j = dim.VMIN; j < dim.VMIN + dim.HEIGHT; j += dim.TILE_SIZE)
+                    results[keyToIndex(Key(i, j))] = collisions->checkRobotValidStateAtTarget(std::vector<float>{(float) i, (float) j, 10},
+                                                                                          std::vector<float>{0.0, 0.0, 0.0});
+                const std::size_t done = ++done_columns;
+                const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::lock_guard<std::mutex> lock(progress_mutex);
+                std::cout << __FUNCTION__ << " Progress: " << done * 100 / cols << "% ETA: "
+                          << elapsed / done * (cols - done) << "s" << std::endl;
             }
-            std::cout << __FUNCTION__ << " Progress: " << i*100/(dim.HMIN+dim.WIDTH) << std::endl;
+        };
+        // all clones are made before the first thread starts, since creating an object rewrites the shared geometry's AABB
+        std::vector<std::shared_ptr<Collisions>> clones;
+        for (unsigned int t = 0; t < n_threads; t++)
+            clones.push_back(collisions_->clone());
+        std::vector<std::thread> pool;
+        for (const auto &clone : clones)
+            pool.emplace_back(sweep, clone);
+        for (auto &t : pool)
+            t.join();
+        std::size_t narrow_phase_calls = 0, footprint_answers = 0;
+        for (const auto &clone : clones)
+        {
+            narrow_phase_calls += clone->get_narrow_phase_calls();
+            footprint_answers += clone->get_footprint_answers();
+        }
+        std::cout << __FUNCTION__ << " Collisions - " << fmap.size() << " cells, " << footprint_answers << " answered by the footprint layer, "
+                  << narrow_phase_calls << " FCL narrow phase calls" << std::endl;
+        for (std::size_t index = 0; index < results.size(); index++)
+        {
+            const auto &[free, node_name] = results[index];
+            fmap[index] = T{static_cast<std::uint32_t>(index), free, true, 1.f, internName(node_name)};
         }
         fmap_aux = fmap;
         if(not file_name.empty())
@@ -47,21 +82,19 @@ void Grid<T>::initialize(const std::shared_ptr<DSR::DSRGraph> &graph_,
 
 
 template <typename T>
-std::tuple<bool, T &> Grid<T>::getCell(long int x, long int z)
+std::tuple<bool, const T &> Grid<T>::getCell(long int x, long int z) const
 {
+    static const T outside{};
     if (!(x >= dim.HMIN and x < dim.HMIN + dim.WIDTH and z >= dim.VMIN and z < dim.VMIN + dim.HEIGHT))
-        return std::forward_as_tuple(false, T());
+        return std::forward_as_tuple(false, outside);
     else
-        return std::forward_as_tuple(true, fmap.at(pointToGrid(x, z)));
+        return std::forward_as_tuple(true, fmap[keyToIndex(pointToGrid(x, z))]);
 }
 
 template <typename T>
-std::tuple<bool, T &> Grid<T>::getCell(const Key &k) //overladed version
+std::tuple<bool, const T &> Grid<T>::getCell(const Key &k) const //overladed version
 {
-    if (!(k.x >= dim.HMIN and k.x < dim.HMIN + dim.WIDTH and k.z >= dim.VMIN and k.z < dim.VMIN + dim.HEIGHT))
-        return std::forward_as_tuple(false, T());
-    else
-        return std::forward_as_tuple(true, fmap.at(pointToGrid(k.x, k.z)));
+    return getCell(k.x, k.z);
 }
 
 template <typename T>
@@ -72,6 +105,47 @@ typename Grid<T>::Key Grid<T>::pointToGrid(long int x, long int z) const
     return Key(dim.HMIN + kx * dim.TILE_SIZE, dim.VMIN + kz * dim.TILE_SIZE);
 };
 
+template <typename T>
+bool Grid<T>::isInside(const Key &k) const
+{
+    return k.x >= dim.HMIN and k.x < dim.HMIN + dim.WIDTH and k.z >= dim.VMIN and k.z < dim.VMIN + dim.HEIGHT;
+}
+
+// outside the grid a key would wrap into the next row, or convert a negative offset to size_t
+template <typename T>
+std::size_t Grid<T>::keyToIndex(const Key &k) const
+{
+    assert(isInside(k));
+    const long int kx = (k.x - dim.HMIN) / dim.TILE_SIZE;
+    const long int kz = (k.z - dim.VMIN) / dim.TILE_SIZE;
+    return kz * cols + kx;
+}
+
+template <typename T>
+std::size_t Grid<T>::checkedIndex(const Key &k) const
+{
+    if (not isInside(k))
+        throw std::out_of_range("Grid: key (" + std::to_string(k.x) + ", " + std::to_string(k.z) + ") is outside the grid");
+    return keyToIndex(k);
+}
+
+template <typename T>
+typename Grid<T>::Key Grid<T>::indexToKey(std::size_t index) const
+{
+    long int kx = index % cols;
+    long int kz = index / cols;
+    return Key(dim.HMIN + kx * dim.TILE_SIZE, dim.VMIN + kz * dim.TILE_SIZE);
+}
+
+template <typename T>
+std::uint16_t Grid<T>::internName(const std::string &name)
+{
+    if (auto it = name_ids.find(name); it != name_ids.end())
+        return it->second;
+    names.push_back(name);
+    return name_ids[name] = static_cast<std::uint16_t>(names.size() - 1);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 template <typename T>
@@ -79,9 +153,10 @@ void Grid<T>::saveToFile(const std::string &fich)
 {
     std::ofstream myfile;
     myfile.open(fich);
-    for (auto &[k, v] : fmap)
+    for (std::size_t i = 0; i < fmap.size(); i++)
     {
-        myfile << k << v << std::endl;
+        const auto &v = fmap[i];
+        myfile << indexToKey(i) << v.free << " " << v.visited << " " << nameOf(v) << std::endl;
     }
     myfile.close();
     std::cout << __FUNCTION__ << " " << fmap.size() << " elements written to " << fich << std::endl;
@@ -92,7 +167,7 @@ void Grid<T>::readFromFile(const std::string &fich)
 {
     std::ifstream myfile(fich);
     std::string line;
-    std::uint32_t count = 0;
+    std::size_t count = 0;
     while ( std::getline (myfile, line) )
     {
         //std::cout << line << std::endl;
@@ -101,9 +176,14 @@ void Grid<T>::readFromFile(const std::string &fich)
         bool free, visited;
         std::string node_name;
         ss >> x >> z >> free >> visited >> node_name;
-        fmap.emplace(pointToGrid(x, z), T{count++, free, false, 1.f, node_name});
+        const auto k = pointToGrid(x, z);
+        if (not isInside(k))
+            continue;
+        const auto index = keyToIndex(k);
+        fmap[index] = T{static_cast<std::uint32_t>(index), free, false, 1.f, internName(node_name)};
+        count++;
     }
-    std::cout << __FUNCTION__ << " " << fmap.size() << " elements read from " << fich << std::endl;
+    std::cout << __FUNCTION__ << " " << count << " elements read from " << fich << std::endl;
 }
 
 template <typename T>
@@ -129,57 +209,57 @@ std::list<QPointF> Grid<T>::computePath(const QPointF &source_, const QPointF &t
         qDebug() << __FUNCTION__ << "Robot already at target. Returning empty path";
         return std::list<QPointF>();
     }
-    // vector de distancias inicializado a DBL_MAX
-    std::vector<double> min_distance(fmap.size(),std::numeric_limits<double>::max());
-    // std::uint32_t id with source value
-    const auto &[success, val] = getCell(source);
-    if(not success)
+    const std::size_t source_index = keyToIndex(source);
+    const std::size_t target_index = keyToIndex(target);
+
+    // A* over cell indices. Stale heap entries are skipped when popped instead of being erased
+    const std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+    min_distance.assign(fmap.size(), std::numeric_limits<double>::max());
+    previous.assign(fmap.size(), none);
+    closed.assign(fmap.size(), false);
+    open_heap.clear();
+    auto heap_comp = [](const std::pair<double, std::uint32_t> &x, const std::pair<double, std::uint32_t> &y) { return x.first > y.first; };
+
+    min_distance[source_index] = 0;
+    open_heap.emplace_back(heuristicOctile(source_index, target_index), source_index);
+    static const int dxs[8] = {1, 1, 1, 0, -1, -1, -1, 0};
+    static const int dzs[8] = {1, 0, -1, -1, -1, 0, 1, 1};
+    while (not open_heap.empty())
     {
-        qWarning() << "Could not find source position in Grid";
-        return std::list<QPointF>();
-    }
-    auto id = val.id;
-    // initialize source position to 0
-    min_distance[id] = 0;
-    // vector de pares<std::uint32_t,Key> initialized to (-1, Key())
-    std::vector<std::pair<std::uint32_t, Key>> previous(fmap.size(), std::make_pair(-1, Key()));
-    // lambda to compare two vertices: a < b if a.id<b.id or
-    auto comp = [this](std::pair<std::uint32_t, Key> x, std::pair<std::uint32_t, Key> y) {
-        if (x.first <= y.first)
-            return true;
-            //else if(x.first == y.first)
-            //	return std::get<T&>(getCell(x.second)).id <= std::get<T&>(getCell(y.second)).id;
-        else
-            return false;
-    };
-
-    // OPEN List
-    std::set<std::pair<std::uint32_t, Key>, decltype(comp)> active_vertices(comp);
-    active_vertices.insert({0, source});
-
-    while (!active_vertices.empty())
-    {
-        Key where = active_vertices.begin()->second;
-        if (where == target)
+        std::pop_heap(open_heap.begin(), open_heap.end(), heap_comp);
+        const std::uint32_t where = open_heap.back().second;
+        open_heap.pop_back();
+        if (closed[where])
+            continue;
+        closed[where] = true;
+        if (where == target_index)
         {
-//				qDebug() << __FILE__ << __FUNCTION__  << "Min distance found:" << min_distance[fmap.at(where).id];  //exit point
-            auto p = orderPath(previous, source, target);
+            auto p = orderPath(previous, source_index, target_index);
             if (p.size() > 1)
                 return p;
             else
                 return std::list<QPointF>();
         }
-        active_vertices.erase(active_vertices.begin());
-        for (auto ed : neighboors_8(where))
+        const long int wx = where % cols;
+        const long int wz = where / cols;
+        for (int n = 0; n < 8; n++)
         {
-//				qDebug() << __FILE__ << __FUNCTION__ << "antes del if" << ed.first.x << ed.first.z << ed.second.id << fmap[where].id << min_distance[ed.second.id] << min_distance[fmap[where].id];
-            if (min_distance[ed.second.id] > min_distance[fmap[where].id] + ed.second.cost)
+            const long int nx = wx + dxs[n];
+            const long int nz = wz + dzs[n];
+            if (nx < 0 or nx >= (long int)cols or nz < 0 or nz >= (long int)rows)
+                continue;
+            const std::uint32_t next = nz * cols + nx;
+            const T &cell = fmap[next];
+            if (not cell.free or closed[next])
+                continue;
+            // same costs as neighboors(): a diagonal step into a plain cell costs 1.41
+            const double step = (dxs[n] != 0 and dzs[n] != 0 and cell.cost == 1) ? 1.41 : cell.cost;
+            if (min_distance[where] + step < min_distance[next])
             {
-                active_vertices.erase({min_distance[ed.second.id], ed.first});
-                min_distance[ed.second.id] = min_distance[fmap[where].id] + ed.second.cost;
-                previous[ed.second.id] = std::make_pair(fmap[where].id, where);
-                active_vertices.insert({min_distance[ed.second.id], ed.first}); // Djikstra
-                // active_vertices.insert( { min_distance[ed.second.id] + heuristicL2(ed.first, target), ed.first } ); //A*
+                min_distance[next] = min_distance[where] + step;
+                previous[next] = where;
+                open_heap.emplace_back(min_distance[next] + heuristicOctile(next, target_index), next);
+                std::push_heap(open_heap.begin(), open_heap.end(), heap_comp);
             }
         }
     }
@@ -188,29 +268,40 @@ std::list<QPointF> Grid<T>::computePath(const QPointF &source_, const QPointF &t
 };
 
 template <typename T>
-bool Grid<T>::isFree(const Key &k)
+bool Grid<T>::isFree(const Key &k) const
 {
-   const auto &[success, v] = getCell(k);
-   if(success)
-       return v.free;
-   else
+    if(not isInside(k))
         return false;
+    return fmap[keyToIndex(pointToGrid(k.x, k.z))].free;
 }
 
 template <typename T>
 void Grid<T>::setFree(const Key &k)
 {
-    auto &[success, v] = getCell(k);
-    if(success)
-        v.free = true;
+    if(not isInside(k))
+        return;
+    const auto index = keyToIndex(pointToGrid(k.x, k.z));
+    if(fmap[index].free)
+        return;
+    fmap[index].free = true;
+    distances_dirty = true;
+    // a new free cell can only merge components, so the labelling is updated in place
+    if(not components_dirty)
+    {
+        component_parent[index] = index;
+        joinFreeNeighbours(index);
+    }
 }
 
 template <typename T>
-bool Grid<T>::cellNearToOccupiedCellByObject(const Key &k, const std::string &target_name)
+bool Grid<T>::cellNearToOccupiedCellByObject(const Key &k, const std::string &target_name) const
 {
+    const auto it = name_ids.find(target_name);
+    if(it == name_ids.end())
+        return false;
     auto neigh = this->neighboors_8(k, true);
     for(const auto &[key, val] : neigh)
-        if(val.free==false and val.node_name==target_name)
+        if(val.free==false and val.name_id==it->second)
             return true;
     return false;
 }
@@ -218,17 +309,98 @@ bool Grid<T>::cellNearToOccupiedCellByObject(const Key &k, const std::string &ta
 template <typename T>
 void Grid<T>::setOccupied(const Key &k)
 {
-    auto &[success, v] = getCell(k);
-    if(success)
-        v.free = false;
+    if(not isInside(k))
+        return;
+    const auto index = keyToIndex(pointToGrid(k.x, k.z));
+    if(not fmap[index].free)
+        return;
+    fmap[index].free = false;
+    // an occupied cell may split a component, which is only resolved by labelling again
+    components_dirty = distances_dirty = true;
+}
+
+template <typename T>
+bool Grid<T>::isReachable(const QPointF &source_, const QPointF &target_)
+{
+    const Key source = pointToGrid(source_.x(), source_.y());
+    const Key target = pointToGrid(target_.x(), target_.y());
+    if(not isInside(source) or not isInside(target))
+        return false;
+    // computePath leaves the source cell out and discards single-cell paths
+    if(std::max(std::labs(source.x - target.x), std::labs(source.z - target.z)) <= dim.TILE_SIZE)
+        return false;
+    const auto target_index = keyToIndex(target);
+    if(not fmap[target_index].free)
+        return false;
+    if(components_dirty)
+        labelComponents();
+    const auto target_component = componentOf(target_index);
+    const auto source_index = keyToIndex(source);
+    if(fmap[source_index].free)
+        return componentOf(source_index) == target_component;
+    // as in computePath, the search may start on an occupied cell and step out to any free neighbour
+    const long int sx = source_index % cols;
+    const long int sz = source_index / cols;
+    for (long int dz = -1; dz <= 1; dz++)
+        for (long int dx = -1; dx <= 1; dx++)
+        {
+            const long int nx = sx + dx, nz = sz + dz;
+            if (nx < 0 or nx >= (long int)cols or nz < 0 or nz >= (long int)rows)
+                continue;
+            const std::size_t next = nz * cols + nx;
+            if (fmap[next].free and componentOf(next) == target_component)
+                return true;
+        }
+    return false;
+}
+
+template <typename T>
+void Grid<T>::labelComponents()
+{
+    component_parent.resize(fmap.size());
+    for (std::size_t i = 0; i < fmap.size(); i++)
+        component_parent[i] = i;
+    for (std::size_t i = 0; i < fmap.size(); i++)
+        if (fmap[i].free)
+            joinFreeNeighbours(i);
+    components_dirty = false;
+}
+
+template <typename T>
+std::uint32_t Grid<T>::componentOf(std::size_t index)
+{
+    while (component_parent[index] != index)
+    {
+        component_parent[index] = component_parent[component_parent[index]];
+        index = component_parent[index];
+    }
+    return index;
 }
 
+// joins the component of a free cell with those of its free 8-neighbours, the moves computePath can make
+template <typename T>
+void Grid<T>::joinFreeNeighbours(std::size_t index)
+{
+    const long int x = index % cols;
+    const long int z = index / cols;
+    for (long int dz = -1; dz <= 1; dz++)
+        for (long int dx = -1; dx <= 1; dx++)
+        {
+            const long int nx = x + dx, nz = z + dz;
+            if ((dx == 0 and dz == 0) or nx < 0 or nx >= (long int)cols or nz < 0 or nz >= (long int)rows)
+                continue;
+            const std::size_t next = nz * cols + nx;
+            if (fmap[next].free)
+                component_parent[componentOf(next)] = componentOf(index);
+        }
+}
+
+// costs are not part of the reachability or distance indexes, so they stay valid
 template <typename T>
 void Grid<T>::setCost(const Key &k,float cost)
 {
-    auto &[success, v] = getCell(k);
-    if(success)
-        v.cost = cost;
+    if(isInside(k))
+        fmap[keyToIndex(pointToGrid(k.x, k.z))].cost = cost;
 }
 
 // if true area becomes free
@@ -261,63 +433,123 @@ void Grid<T>::modifyCostInGrid(const QPolygonF &poly, float cost)
                 setCost(pointToGrid(x, y),cost);
 }
 
+// vector from the closest occupied cell to the cell holding center, read from the distance field. The cell itself
+// is never returned, so the vector is not null: an occupied cell gets the closest other obstacle
 template <typename T>
 std::tuple<bool, QVector2D> Grid<T>::vectorToClosestObstacle(QPointF center)
 {
-    QTime reloj = QTime::currentTime();
-    qDebug()<<" reloj "<< reloj.restart();
-    qDebug()<< "Computing neighboors of " << center;
-    auto k = pointToGrid(center.x(),center.y());
-    QVector2D closestVector;
-    bool obstacleFound = false;
+    const auto k = pointToGrid(center.x(), center.y());
+    if(not isInside(k))
+        return std::make_tuple(false, QVector2D());
+    if(distances_dirty)
+        computeDistanceField();
+    const auto index = keyToIndex(k);
+    const auto obstacle = fmap[index].free ? nearest_obstacle[index] : nearestOtherObstacle(index);
+    if(obstacle == std::numeric_limits<std::uint32_t>::max())
+        return std::make_tuple(false, QVector2D());
+    const auto ok = indexToKey(obstacle);
+    return std::make_tuple(true, QVector2D(k.x - ok.x, k.z - ok.z));
+}
 
-    auto neigh = neighboors_8(k, true);
-    float dist = std::numeric_limits<float>::max();
-    for (auto n : neigh)
-    {
-        if (n.second.free == false)
-        {
-           QVector2D vec = QVector2D(QPointF(k.x, k.z)) - QVector2D(QPointF(n.first.x,n.first.z)) ;
-            if (vec.length() < dist)
+// the distance field maps an occupied cell to itself, so its neighbours are searched in rings of growing radius. Every
+// cell of ring r is at least r cells away, so the search stops once that is farther than the best one found
+template <typename T>
+std::uint32_t Grid<T>::nearestOtherObstacle(std::size_t index) const
+{
+    const long int cx = index % cols;
+    const long int cz = index / cols;
+    std::uint32_t best = std::numeric_limits<std::uint32_t>::max();
+    long int best_d2 = std::numeric_limits<long int>::max();
+    const long int max_r = std::max(cols, rows);
+    for (long int r = 1; r <= max_r and r * r <= best_d2; r++)
+        for (long int dz = -r; dz <= r; dz++)
+            for (long int dx = -r; dx <= r; dx += (std::labs(dz) == r ? 1 : 2 * r))
             {
-                dist = vec.length();
-                closestVector = vec;
+                const long int nx = cx + dx, nz = cz + dz;
+                if (nx < 0 or nx >= (long int)cols or nz < 0 or nz >= (long int)rows)
+                    continue;
+                const std::size_t next = nz * cols + nx;
+                if (not fmap[next].free and dx * dx + dz * dz < best_d2)
+                {
+                    best_d2 = dx * dx + dz * dz;
+                    best = next;
+                }
             }
-            qDebug() << __FUNCTION__ << "Obstacle found";
-            obstacleFound = true;
+    return best;
+}
+
+/**
+ @brief Exact Euclidean nearest occupied cell for every cell (Felzenszwalb-Huttenlocher), linear in the number of cells.
+ A pass along each column finds the closest obstacle in it, and a lower envelope of parabolas along each row picks
+ the best column.
+*/
+template <typename T>
+void Grid<T>::computeDistanceField()
+{
+    const std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+    const double far = 1e20;
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> column_dist2(fmap.size());
+    std::vector<std::uint32_t> column_obstacle(fmap.size(), none);   // row of the closest obstacle in the same column
+    for (std::size_t x = 0; x < cols; x++)
+    {
+        std::uint32_t last = none;
+        for (std::size_t z = 0; z < rows; z++)
+        {
+            if (not fmap[z * cols + x].free) last = z;
+            column_obstacle[z * cols + x] = last;
+        }
+        last = none;
+        for (std::size_t z = rows; z-- > 0;)
+        {
+            const std::size_t index = z * cols + x;
+            if (not fmap[index].free) last = z;
+            if (last != none and (column_obstacle[index] == none or last - z < z - column_obstacle[index]))
+                column_obstacle[index] = last;
+            const double dz = column_obstacle[index] == none ? 0. : (double)z - column_obstacle[index];
+            column_dist2[index] = column_obstacle[index] == none ? far : dz * dz;
         }
     }
-
-    if (!obstacleFound)
+    nearest_obstacle.assign(fmap.size(), none);
+    std::vector<std::size_t> sites(cols);
+    std::vector<double> bounds(cols + 1);
+    for (std::size_t z = 0; z < rows; z++)
     {
-        auto DistNeigh = neighboors_16(k, true);
-        for (auto n : DistNeigh)
+        const double *f = &column_dist2[z * cols];
+        // abscissa where the parabolas of columns q and v cross
+        auto intersection = [f](double q, double v) { return ((f[(std::size_t)q] + q * q) - (f[(std::size_t)v] + v * v)) / (2. * q - 2. * v); };
+        std::size_t k = 0;
+        sites[0] = 0; bounds[0] = -inf; bounds[1] = inf;
+        for (std::size_t q = 1; q < cols; q++)
         {
-            if (n.second.free == false)
-            {
-                QVector2D vec = QVector2D(QPointF(k.x, k.z)) - QVector2D(QPointF(n.first.x, n.first.z)) ;
-                if (vec.length() < dist)
-                {
-                    dist = vec.length();
-                    closestVector = vec;
-                }
-                obstacleFound = true;
-            }
+            double s = intersection(q, sites[k]);
+            while (s <= bounds[k])
+                s = intersection(q, sites[--k]);
+            k++;
+            sites[k] = q; bounds[k] = s; bounds[k + 1] = inf;
+        }
+        k = 0;
+        for (std::size_t q = 0; q < cols; q++)
+        {
+            while (bounds[k + 1] < q) k++;
+            const std::size_t site = z * cols + sites[k];
+            if (column_obstacle[site] != none)
+                nearest_obstacle[z * cols + q] = column_obstacle[site] * cols + sites[k];
         }
     }
-    return std::make_tuple(obstacleFound,closestVector);
+    distances_dirty = false;
 }
 
 template <typename T>
-std::vector<std::pair<typename Grid<T>::Key, T>> Grid<T>::neighboors(const Grid<T>::Key &k, const std::vector<int> xincs,const std::vector<int> zincs, bool all)
+std::vector<std::pair<typename Grid<T>::Key, T>> Grid<T>::neighboors(const Grid<T>::Key &k, const std::vector<int> xincs,const std::vector<int> zincs, bool all) const
 {
     std::vector<std::pair<Key, T>> neigh;
     // list of increments to access the neighboors of a given position
     for (auto &&[itx, itz] : iter::zip(xincs, zincs))
     {
         Key lk{k.x + itx, k.z + itz};
-        const auto &[success, p] = getCell(lk);
-        if(not success) continue;
+        if(not isInside(lk)) continue;
+        T p = fmap[keyToIndex(pointToGrid(lk.x, lk.z))];
 
         // check that incs are not both zero but have the same abs value, i.e. a diagonal
         if (itx != 0 and itz != 0 and (fabs(itx) == fabs(itz)) and p.cost==1)
@@ -333,7 +565,7 @@ std::vector<std::pair<typename Grid<T>::Key, T>> Grid<T>::neighboors(const Grid<
 }
 
 template <typename T>
-std::vector<std::pair<typename Grid<T>::Key, T>> Grid<T>::neighboors_8(const Grid<T>::Key &k, bool all)
+std::vector<std::pair<typename Grid<T>::Key, T>> Grid<T>::neighboors_8(const Grid<T>::Key &k, bool all) const
 {
     const int &I = dim.TILE_SIZE;
     static const std::vector<int> xincs = {I, I, I, 0, -I, -I, -I, 0};
@@ -342,7 +574,7 @@ std::vector<std::pair<typename Grid<T>::Key, T>> Grid<T>::neighboors_8(const Gri
 }
 
 template <typename T>
-std::vector<std::pair<typename Grid<T>::Key, T>> Grid<T>::neighboors_16(const Grid<T>::Key &k, bool all)
+std::vector<std::pair<typename Grid<T>::Key, T>> Grid<T>::neighboors_16(const Grid<T>::Key &k, bool all) const
 {
     const int &I = dim.TILE_SIZE;
     static const std::vector<int> xincs = {0,   I,   2*I,  2*I, 2*I, 2*I, 2*I, I, 0, -I, -2*I, -2*I,-2*I,-2*I,-2*I, -I};
@@ -351,19 +583,16 @@ std::vector<std::pair<typename Grid<T>::Key, T>> Grid<T>::neighboors_16(const Gr
 }
 
 /**
- @brief Recovers the optimal path from the list of previous nodes
+ @brief Recovers the optimal path from the list of previous nodes. The source cell is not included
 */
 template <typename T>
-std::list<QPointF> Grid<T>::orderPath(const std::vector<std::pair<std::uint32_t, Key>> &previous, const Key &source, const Key &target)
+std::list<QPointF> Grid<T>::orderPath(const std::vector<std::uint32_t> &previous, std::size_t source, std::size_t target)
 {
     std::list<QPointF> res;
-    Key k = target;
-    std::uint32_t u = fmap.at(k).id;
-    while (previous[u].first != (std::uint32_t)-1)
+    for (std::size_t u = target; u != source and u != std::numeric_limits<std::uint32_t>::max(); u = previous[u])
     {
+        const auto k = indexToKey(u);
         res.push_front(QPointF(k.x, k.z));
-        u = previous[u].first;
-        k = previous[u].second;
     }
     //qDebug() << __FILE__ << __FUNCTION__ << "Path length:" << res.size();  //exit point
     return res;
@@ -375,6 +604,15 @@ inline double Grid<T>::heuristicL2(const Key &a, const Key &b) const
     return sqrt((a.x - b.x) * (a.x - b.x) + (a.z - b.z) * (a.z - b.z));
 }
 
+// distance in cells with the 1.41 diagonal cost used by the search, so it never overestimates
+template <typename T>
+inline double Grid<T>::heuristicOctile(std::size_t a, std::size_t b) const
+{
+    const long int dx = std::labs((long int)(a % cols) - (long int)(b % cols));
+    const long int dz = std::labs((long int)(a / cols) - (long int)(b / cols));
+    return std::max(dx, dz) + 0.41 * std::min(dx, dz);
+}
+
 template <typename T>
 void Grid<T>::draw(QGraphicsScene* scene)
 {
@@ -385,8 +623,10 @@ void Grid<T>::draw(QGraphicsScene* scene)
     scene_grid_points.clear();
     //create new representation
     std::string color;
-    for( const auto &[key,value] : fmap)
+    for (std::size_t i = 0; i < fmap.size(); i++)
     {
+        const auto &value = fmap[i];
+        const auto key = indexToKey(i);
         if(value.free)
         {
             if (value.cost == 2.0) //affordance spaces
@@ -419,6 +659,7 @@ template <typename T>
 void Grid<T>::clear()
 {
     fmap.clear();
+    components_dirty = distances_dirty = true;
 }
 
 template <class T>
@@ -24,6 +24,15 @@
 #include <cppitertools/zip.hpp>
 #include <cppitertools/range.hpp>
 #include <limits>
+#include <stdexcept>
+#include <cassert>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
 #include <collisions.h>
 #include <QGraphicsScene>
 
@@ -34,12 +43,7 @@ struct TCellDefault
     bool free;
     bool visited;
     float cost;
-    std::string node_name;
-    //bool
-
-    // method to save the value
-    void save(std::ostream &os) const {	os << free << " " << visited << " " << node_name; };
-    void read(std::istream &is) {	is >> free >> visited >> node_name;};
+    std::uint16_t name_id;   // name of the occupying object, interned by Grid. 0 is no object
 };
 
 template <typename T = TCellDefault>
@@ -88,7 +92,8 @@ class Grid
                 return seed;
             };
         };
-        using FMap = std::unordered_map<Key, T, KeyHasher>;
+        // cells are stored row-major (z rows of x columns) and the cell id is its index in the array
+        using FMap = std::vector<T>;
         Dimensions dim;
 
         void initialize(const std::shared_ptr<DSR::DSRGraph> &graph_,
@@ -96,47 +101,84 @@ class Grid
                         Dimensions dim_,
                         bool read_from_file = true,
                         const std::string &file_name = std::string());
-        std::tuple<bool, T &> getCell(long int x, long int z);
-        std::tuple<bool, T &> getCell(const Key &k);
-        T at(const Key &k) const                            { return fmap.at(k);};
-        T &at(const Key &k)                                 { return fmap.at(k);};
-        typename FMap::iterator begin()                     { return fmap.begin(); };
-        typename FMap::iterator end()                       { return fmap.end(); };
+        // cells are read only through these. They change through setFree, setOccupied, setCost and insert, which keep
+        // the reachability and distance indexes up to date
+        std::tuple<bool, const T &> getCell(long int x, long int z) const;
+        std::tuple<bool, const T &> getCell(const Key &k) const;
+        const T &at(const Key &k) const                     { return fmap[checkedIndex(k)];};
         typename FMap::const_iterator begin() const         { return fmap.begin(); };
-        typename FMap::const_iterator end() const           { return fmap.begin(); };
+        typename FMap::const_iterator end() const           { return fmap.end(); };
         size_t size() const                                 { return fmap.size(); };
         FMap getMap()                                       { return fmap_aux; }
-        void resetGrid()                                    { fmap = fmap_aux; }
+        void resetGrid()                                    { fmap = fmap_aux; components_dirty = distances_dirty = true; }
+        // overwrites the cell. The unordered_map version kept an existing entry, and as initialize() creates every
+        // cell, it never changed a cell inside the grid
         template <typename Q>
         void insert(const Key &key, const Q &value)
         {
-            fmap.insert(std::make_pair(key, value));
+            if (isInside(key))
+                fmap[keyToIndex(key)] = value;
+            components_dirty = distances_dirty = true;
         }
         void clear();
         void saveToFile(const std::string &fich);
         void readFromFile(const std::string &fich);
         std::list<QPointF> computePath(const QPointF &source_, const QPointF &target_);
         Key pointToGrid(long int x, long int z) const;
+        bool isInside(const Key &k) const;
+        std::size_t keyToIndex(const Key &k) const;   // k must be inside the grid
+        Key indexToKey(std::size_t index) const;
+        std::uint16_t internName(const std::string &name);
+        const std::string &nameOf(const T &cell) const      { return names.at(cell.name_id); };
         void setFree(const Key &k);
-        bool isFree(const Key &k) ;
-        bool cellNearToOccupiedCellByObject(const Key &k, const std::string &target_name);
+        bool isFree(const Key &k) const;
+        bool cellNearToOccupiedCellByObject(const Key &k, const std::string &target_name) const;
         void setOccupied(const Key &k);
+        // true if computePath would return a non-empty path, so false for a target in the source cell or next to it
+        bool isReachable(const QPointF &source_, const QPointF &target_);
         void setCost(const Key &k,float cost);
         void markAreaInGridAs(const QPolygonF &poly, bool free);   // if true area becomes free
         void modifyCostInGrid(const QPolygonF &poly, float cost);
+        // closest obstacle at any distance other than the cell holding center, answered from a distance field rebuilt
+        // lazily after cells change
         std::tuple<bool, QVector2D> vectorToClosestObstacle(QPointF center);
-        std::vector<std::pair<Key, T>> neighboors(const Key &k, const std::vector<int> xincs,const std::vector<int> zincs, bool all = false);
-        std::vector<std::pair<Key, T>> neighboors_8(const Key &k,  bool all = false);
-        std::vector<std::pair<Key, T>> neighboors_16(const Key &k,  bool all = false);
+        std::vector<std::pair<Key, T>> neighboors(const Key &k, const std::vector<int> xincs,const std::vector<int> zincs, bool all = false) const;
+        std::vector<std::pair<Key, T>> neighboors_8(const Key &k,  bool all = false) const;
+        std::vector<std::pair<Key, T>> neighboors_16(const Key &k,  bool all = false) const;
         void draw(QGraphicsScene* scene);
         Dimensions getDim() const                           { return dim;};  //deprecated
 
     private:
         FMap fmap, fmap_aux;
+        std::size_t cols = 0, rows = 0;
+        std::vector<std::string> names{""};
+        std::unordered_map<std::string, std::uint16_t> name_ids{{"", 0}};
         std::shared_ptr<DSR::DSRGraph> G;
         std::vector<QGraphicsRectItem *> scene_grid_points;
-        std::list<QPointF> orderPath(const std::vector<std::pair<std::uint32_t, Key>> &previous, const Key &source, const Key &target);
+        // index of k, or std::out_of_range if k is outside the grid, as unordered_map::at threw before
+        std::size_t checkedIndex(const Key &k) const;
+        std::list<QPointF> orderPath(const std::vector<std::uint32_t> &previous, std::size_t source, std::size_t target);
         inline double heuristicL2(const Key &a, const Key &b) const;
+        inline double heuristicOctile(std::size_t a, std::size_t b) const;
+
+        // A* buffers, kept across computePath calls so a query does not allocate
+        std::vector<double> min_distance;
+        std::vector<std::uint32_t> previous;
+        std::vector<bool> closed;
+        std::vector<std::pair<double, std::uint32_t>> open_heap;
+
+        // union-find over cells, free cells in the same set are connected
+        std::vector<std::uint32_t> component_parent;
+        bool components_dirty = true;
+
+        // index of the closest occupied cell to each cell, or max() if there is none
+        std::vector<std::uint32_t> nearest_obstacle;
+        bool distances_dirty = true;
+        void computeDistanceField();
+        std::uint32_t nearestOtherObstacle(std::size_t index) const;
+        void labelComponents();
+        std::uint32_t componentOf(std::size_t index);
+        void joinFreeNeighbours(std::size_t index);
 };
 
 
@@ -517,11 +517,12 @@ void Navigation<TMap, TController>::computeForces(std::vector<QPointF> &path, co
     }
 }
 
+// navigation.cpp is not in SOURCES and nothing includes it, so this is not built. The planner's own reachability
+// check is in SpecificWorker::compute
 template<typename TMap, typename TController>
 bool Navigation<TMap, TController>::isPointVisitable(QPointF point)
 {
-    std::list<QPointF> path = grid.computePath(currentRobotNose, point);
-    if (path.size() == 0)
+    if (not grid.isReachable(currentRobotNose, point))
     {
         qDebug()<< "Point not visitable -----";
         return false;
@@ -156,6 +156,9 @@ void SpecificMonitor::readConfig(RoboCompCommonBehavior::ParameterList &params )
 	configGetString( "NavigationAgent","ExcludedObjectsInCollisionCheck", aux.value,"floor_plane");
 	params["ExcludedObjectsInCollisionCheck"] = aux;
 
+	configGetString( "NavigationAgent","BVHCacheDir", aux.value,"/tmp/dsr_bvh_cache");
+	params["BVHCacheDir"] = aux;
+
 	configGetString( "NavigationAgent","MinimumDetectableRotation", aux.value,"0.03");
 	params["MinimumDetectableRotation"] = aux;
 
@@ -94,6 +94,7 @@ void SpecificWorker::initialize(int period)
 
 		// path planner
 		path_planner_initialize(&widget_2d->scene, true, "viriato-200-vrep.simscene.grid");
+		connect(G.get(), &DSR::DSRGraph::update_edge_signal, this, &SpecificWorker::update_edge_slot);
 
         widget_2d->set_draw_laser(true);
 		connect(widget_2d, SIGNAL(mouse_right_click(int, int, int)), this, SLOT(new_target_from_mouse(int,int,int)));
@@ -119,9 +120,9 @@ void SpecificWorker::compute()
         if( auto robot_o = G->get_node(robot_name); robot_o.has_value())
         {
            auto robot = robot_o.value();
-            if( auto intention_nodes = G->get_nodes_by_type(intention_type); not intention_nodes.empty())
+            if( auto intention_node_o = get_first_node_of_type(intention_type, intention_id); intention_node_o.has_value())
             {
-                auto intention_node = intention_nodes.front();
+                auto intention_node = intention_node_o.value();
                 if (auto target_o = G->get_node(current_plan.target_place); target_o.has_value())
                 {
                     auto target = target_o.value();
@@ -137,7 +138,17 @@ void SpecificWorker::compute()
                             std::cout << __FUNCTION__ << " Candidate found on floor: " << std::endl;
                             nose_3d = inner_eigen->transform(world_name, Mat::Vector3d(0, 380, 0), robot_name).value();
                             currentRobotNose = QPointF(nose_3d.x(), nose_3d.y());
-                            path = grid.computePath(currentRobotNose, QPointF(candidate.x(), candidate.y()));
+                            // the connected-component index answers unreachable targets without running the search
+                            if (not grid.isReachable(currentRobotNose, QPointF(candidate.x(), candidate.y())))
+                                qInfo() << __FUNCTION__ << " Candidate not reachable from the robot nose";
+                            else
+                                path = grid.computePath(currentRobotNose, QPointF(candidate.x(), candidate.y()));
+                            if (not path.empty())
+                            {
+                                const auto robot_3d = inner_eigen->transform(world_name, Mat::Vector3d(0, 0, 0), robot_name).value();
+                                if (not path_is_collision_free(QPointF(robot_3d.x(), robot_3d.y()), path))
+                                    path.clear();
+                            }
                             qInfo() << __FUNCTION__ << " Path size: " << path.size();
                             for (auto &&p: path)
                                 qInfo() << p;
@@ -151,9 +162,9 @@ void SpecificWorker::compute()
                                 y_values.reserve(path.size());
                                 std::transform(path.cbegin(), path.cend(), std::back_inserter(y_values),
                                                [](const auto &value) { return value.y(); });
-                                if (auto node_paths = G->get_nodes_by_type(path_to_target_type); not node_paths.empty())
+                                if (auto path_node_o = get_first_node_of_type(path_to_target_type, path_to_target_id); path_node_o.has_value())
                                 {
-                                    auto path_to_target_node = node_paths.front();
+                                    auto path_to_target_node = path_node_o.value();
                                     G->add_or_modify_attrib_local<path_x_values_att>(path_to_target_node, x_values);
                                     G->add_or_modify_attrib_local<path_y_values_att>(path_to_target_node, y_values);
                                     G->add_or_modify_attrib_local<path_target_x_att>(path_to_target_node,
@@ -177,6 +188,7 @@ void SpecificWorker::compute()
                                                                                      (float) candidate.y());
 
                                     auto id = G->insert_node(path_to_target_node);
+                                    path_to_target_id = id.value();
                                     auto edge_to_intention = Edge(id.value(), intention_node.id(), think_type,
                                                                   agent_id);
                                     G->insert_or_assign_edge(edge_to_intention);
@@ -199,6 +211,44 @@ void SpecificWorker::compute()
     }
 }
 
+// Returns the first node of the given type. The id found in the previous call is tried first so the
+// whole graph is only scanned when that node has been deleted or was never found
+std::optional<Node> SpecificWorker::get_first_node_of_type(const std::string &type, std::optional<std::uint32_t> &last_id)
+{
+    if (last_id.has_value())
+    {
+        if (auto node = G->get_node(last_id.value()); node.has_value() and node.value().type() == type)
+            return node;
+        last_id.reset();
+    }
+    if (auto nodes = G->get_nodes_by_type(type); not nodes.empty())
+    {
+        last_id = nodes.front().id();
+        return nodes.front();
+    }
+    return {};
+}
+
+// the grid only checked the cell centres, so each step between them is swept by the robot as it was in the grid sweep.
+// computePath leaves out the source, so the sweep starts at the robot's current position
+bool SpecificWorker::path_is_collision_free(const QPointF &robot, const std::list<QPointF> &path)
+{
+    std::list<QPointF> steps(path);
+    steps.push_front(robot);
+    for (auto from = steps.cbegin(), to = std::next(from); from != steps.cend() and to != steps.cend(); ++from, ++to)
+    {
+        const auto &[free, obstacle] = collisions->checkRobotValidSegment(std::vector<float>{(float)from->x(), (float)from->y(), 10},
+                                                                          std::vector<float>{(float)to->x(), (float)to->y(), 10},
+                                                                          std::vector<float>{0.0, 0.0, 0.0});
+        if (not free)
+        {
+            qWarning() << __FUNCTION__ << "Path discarded, step from" << *from << "to" << *to << "hits" << QString::fromStdString(obstacle);
+            return false;
+        }
+    }
+    return true;
+}
+
 void SpecificWorker::path_planner_initialize(QGraphicsScene *scene, bool read_from_file, const std::string file_name)
 {
     QRectF outerRegion;
@@ -372,6 +422,13 @@ void SpecificWorker::update_node_slot(const std::int32_t id, const std::string &
     }
 }
 
+// world meshes stay placed in the collision broad phase, so those below a changed RT edge are moved with it
+void SpecificWorker::update_edge_slot(const std::int32_t from, const std::int32_t to, const std::string &type)
+{
+    if (type == rt_type)
+        collisions->update_world_meshes_below(to, inner_eigen);
+}
+
 //////////////////////////////////////////////7
 /// parser form JSON plan to Plan structure
 void SpecificWorker::json_to_plan(const std::string &plan_string, Plan &plan)
@@ -76,6 +76,7 @@ class SpecificWorker : public GenericWorker
         void initialize(int period);
         void new_target_from_mouse(int pos_x, int pos_y, int id);
         void update_node_slot(const std::int32_t id, const std::string &type);
+        void update_edge_slot(const std::int32_t from, const std::int32_t to, const std::string &type);
 
     private:
         // DSR graph
@@ -120,6 +121,11 @@ class SpecificWorker : public GenericWorker
         Mat::Vector3d robotBottomLeft, robotBottomRight, robotTopRight, robotTopLeft;
         Grid<>::Dimensions dim;
         void draw_path( std::list<QPointF> &path, QGraphicsScene *viewer_2d);
+        bool path_is_collision_free(const QPointF &robot, const std::list<QPointF> &path);
+
+        // ids of singleton nodes, to avoid scanning G by type in every plan
+        std::optional<std::uint32_t> intention_id, path_to_target_id;
+        std::optional<Node> get_first_node_of_type(const std::string &type, std::optional<std::uint32_t> &last_id);
 
 };
 
@@ -0,0 +1,45 @@
+//
+// Collisions unit tests on a small world: a 400 mm cube robot at the origin and a 20 mm wall at x = 1000.
+// Not in TEST_SOURCES yet: add it there once it has been built and run against FCL and DSR
+//
+
+#include "catch.hpp"
+#include "../collisions.h"
+
+static const std::string collisions_world_file = std::string(PATH_PLANNER_ASTAR_DIR) + "/src/unittests/testfiles/collisions_world.json";
+
+static std::shared_ptr<Collisions> collisions_in_test_world()
+{
+    static auto G = std::make_shared<DSR::DSRGraph>(0, "collisions_test", 1552, collisions_world_file, nullptr);
+    auto params = std::make_shared<RoboCompCommonBehavior::ParameterList>();
+    (*params)["ExcludedObjectsInCollisionCheck"].value = "infiniteFloor";
+    auto collisions = std::make_shared<Collisions>();
+    collisions->initialize(G, params);
+    return collisions;
+}
+
+TEST_CASE("Robot segment against the world", "[COLLISIONS]") {
+
+    auto collisions = collisions_in_test_world();
+    const std::vector<float> upright{0, 0, 0};
+
+    SECTION("A segment through the wall hits it, though both ends are free") {
+        const std::vector<float> source{0, 0, 10}, target{2000, 0, 10};
+        REQUIRE(std::get<bool>(collisions->checkRobotValidStateAtTarget(source, upright)));
+        REQUIRE(std::get<bool>(collisions->checkRobotValidStateAtTarget(target, upright)));
+        const auto &[free, obstacle] = collisions->checkRobotValidSegment(source, target, upright);
+        REQUIRE_FALSE(free);
+        REQUIRE(obstacle == "wall");
+    }
+
+    SECTION("A segment past the end of the wall clears it") {
+        const auto &[free, obstacle] = collisions->checkRobotValidSegment({0, 1500, 10}, {2000, 1500, 10}, upright);
+        REQUIRE(free);
+        REQUIRE(obstacle.empty());
+    }
+
+    SECTION("Grazing the wall end, a 5 mm gap clears and a 5 mm overlap hits") {
+        REQUIRE(std::get<bool>(collisions->checkRobotValidSegment({0, 1205, 10}, {2000, 1205, 10}, upright)));
+        REQUIRE_FALSE(std::get<bool>(collisions->checkRobotValidSegment({0, 1195, 10}, {2000, 1195, 10}, upright)));
+    }
+}
@@ -0,0 +1,248 @@
+//
+// Grid unit tests on the grid files stored with the component
+//
+
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include "catch.hpp"
+#include "../grid.cpp"
+#include <map>
+#include <queue>
+#include <random>
+
+static const std::string simscene_grid_file = std::string(PATH_PLANNER_ASTAR_DIR) + "/viriato-200-vrep.simscene.grid";
+
+// outer region of autonomyLab_complete.simscene with the 200 mm tiles the grid file was saved with
+static Grid<>::Dimensions simscene_dimensions()
+{
+    Grid<>::Dimensions dim;
+    dim.TILE_SIZE = 200;
+    dim.HMIN = -7500; dim.VMIN = -7500;
+    dim.WIDTH = 15000; dim.HEIGHT = 15000;
+    return dim;
+}
+
+// plain Dijkstra over keys with the step costs of computePath, or -1 if target cannot be reached
+static double reference_cost(Grid<> &grid, const Grid<>::Key &source, const Grid<>::Key &target)
+{
+    const int I = grid.dim.TILE_SIZE;
+    using Entry = std::pair<double, std::pair<long int, long int>>;
+    std::map<std::pair<long int, long int>, double> dist{{{source.x, source.z}, 0.}};
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    open.push({0., {source.x, source.z}});
+    while (not open.empty())
+    {
+        const auto [d, k] = open.top();
+        open.pop();
+        if (d > dist[k]) continue;
+        if (k.first == target.x and k.second == target.z) return d;
+        for (int dx = -1; dx <= 1; dx++)
+            for (int dz = -1; dz <= 1; dz++)
+            {
+                const Grid<>::Key next(k.first + dx * I, k.second + dz * I);
+                if ((dx == 0 and dz == 0) or not grid.isInside(next) or not grid.at(next).free) continue;
+                const double step = (dx != 0 and dz != 0 and grid.at(next).cost == 1) ? 1.41 : grid.at(next).cost;
+                const auto nk = std::make_pair(next.x, next.z);
+                if (auto it = dist.find(nk); it == dist.end() or d + step < it->second)
+                {
+                    dist[nk] = d + step;
+                    open.push({d + step, nk});
+                }
+            }
+    }
+    return -1;
+}
+
+TEST_CASE("Grid read from file", "[GRID]") {
+
+    Grid<> grid;
+    grid.initialize(nullptr, nullptr, simscene_dimensions(), true, simscene_grid_file);
+
+    SECTION("Every cell in the file is loaded") {
+        REQUIRE(grid.size() == 75 * 75);
+        REQUIRE(std::count_if(grid.begin(), grid.end(), [](const auto &cell) { return cell.free; }) == 4703);
+    }
+
+    SECTION("Cell ids are their index") {
+        for (std::size_t i = 0; i < grid.size(); i++)
+            REQUIRE(grid.keyToIndex(grid.indexToKey(i)) == i);
+    }
+
+    SECTION("at() throws for keys outside the grid instead of wrapping into the next row") {
+        const auto &dim = grid.dim;
+        const auto &const_grid = grid;
+        REQUIRE_NOTHROW(const_grid.at(Grid<>::Key(dim.HMIN, dim.VMIN)));
+        REQUIRE_THROWS_AS(const_grid.at(Grid<>::Key(dim.HMIN + dim.WIDTH, dim.VMIN)), std::out_of_range);
+        REQUIRE_THROWS_AS(const_grid.at(Grid<>::Key(dim.HMIN - dim.TILE_SIZE, dim.VMIN)), std::out_of_range);
+        REQUIRE_THROWS_AS(const_grid.at(Grid<>::Key(dim.HMIN, dim.VMIN + dim.HEIGHT)), std::out_of_range);
+    }
+}
+
+TEST_CASE("Compute path", "[GRID]") {
+
+    Grid<> grid;
+    grid.initialize(nullptr, nullptr, simscene_dimensions(), true, simscene_grid_file);
+    const int I = grid.dim.TILE_SIZE;
+    std::vector<Grid<>::Key> free_cells;
+    for (std::size_t i = 0; i < grid.size(); i++)
+        if (grid.at(grid.indexToKey(i)).free)
+            free_cells.push_back(grid.indexToKey(i));
+
+    SECTION("Path to the same cell is empty") {
+        const auto k = free_cells.front();
+        REQUIRE(grid.computePath(QPointF(k.x, k.z), QPointF(k.x + I / 2, k.z + I / 2)).empty());
+    }
+
+    SECTION("Path to a target out of the grid is empty") {
+        const auto k = free_cells.front();
+        REQUIRE(grid.computePath(QPointF(k.x, k.z), QPointF(20000, 20000)).empty());
+    }
+
+    SECTION("Path to an occupied cell is empty") {
+        const auto k = free_cells.front();
+        const auto occupied = std::find_if(grid.begin(), grid.end(), [](const auto &cell) { return not cell.free; });
+        REQUIRE(occupied != grid.end());
+        const auto ok = grid.indexToKey(occupied->id);
+        REQUIRE(grid.computePath(QPointF(k.x, k.z), QPointF(ok.x, ok.z)).empty());
+    }
+
+    SECTION("Paths between random free cells are connected, free and as short as Dijkstra's") {
+        std::mt19937 gen(0);
+        std::uniform_int_distribution<std::size_t> dis(0, free_cells.size() - 1);
+        for (int q = 0; q < 200; q++)
+        {
+            const auto source = free_cells[dis(gen)];
+            const auto target = free_cells[dis(gen)];
+            const auto path = grid.computePath(QPointF(source.x, source.z), QPointF(target.x, target.z));
+            // computePath leaves out the source cell and returns nothing for a single-cell path
+            const bool adjacent = std::max(std::labs(source.x - target.x), std::labs(source.z - target.z)) <= I;
+            const double expected = adjacent ? -1 : reference_cost(grid, source, target);
+            if (expected < 0)
+            {
+                REQUIRE(path.empty());
+                continue;
+            }
+            REQUIRE_FALSE(path.empty());
+            double cost = 0;
+            Grid<>::Key previous = source;
+            for (const auto &p : path)
+            {
+                const Grid<>::Key k((long int)p.x(), (long int)p.y());
+                const long int dx = std::labs(k.x - previous.x), dz = std::labs(k.z - previous.z);
+                REQUIRE(std::max(dx, dz) == I);
+                REQUIRE(grid.at(k).free);
+                cost += (dx != 0 and dz != 0 and grid.at(k).cost == 1) ? 1.41 : grid.at(k).cost;
+                previous = k;
+            }
+            REQUIRE(previous == target);
+            REQUIRE(cost == Approx(expected));
+        }
+    }
+}
+
+TEST_CASE("Reachability", "[GRID]") {
+
+    Grid<> grid;
+    grid.initialize(nullptr, nullptr, simscene_dimensions(), true, simscene_grid_file);
+    const int I = grid.dim.TILE_SIZE;
+    std::vector<Grid<>::Key> free_cells;
+    for (std::size_t i = 0; i < grid.size(); i++)
+        if (grid.isFree(grid.indexToKey(i)))
+            free_cells.push_back(grid.indexToKey(i));
+    auto reachable = [&grid](const Grid<>::Key &s, const Grid<>::Key &t) { return grid.isReachable(QPointF(s.x, s.z), QPointF(t.x, t.z)); };
+    auto has_path = [&grid](const Grid<>::Key &s, const Grid<>::Key &t) { return not grid.computePath(QPointF(s.x, s.z), QPointF(t.x, t.z)).empty(); };
+
+    SECTION("A target in the source cell is not reachable") {
+        const auto k = free_cells.front();
+        REQUIRE_FALSE(grid.isReachable(QPointF(k.x, k.z), QPointF(k.x + I / 2, k.z + I / 2)));
+    }
+
+    SECTION("A free target next to the source is not reachable, as computePath returns no path") {
+        const auto k = *std::find_if(free_cells.begin(), free_cells.end(), [&grid, I](const auto &c) { return grid.isFree(Grid<>::Key(c.x + I, c.z)); });
+        const Grid<>::Key next(k.x + I, k.z);
+        REQUIRE_FALSE(has_path(k, next));
+        REQUIRE_FALSE(reachable(k, next));
+    }
+
+    SECTION("Agrees with computePath on random pairs") {
+        std::mt19937 gen(1);
+        std::uniform_int_distribution<std::size_t> dis(0, free_cells.size() - 1);
+        for (int q = 0; q < 300; q++)
+        {
+            const auto s = free_cells[dis(gen)], t = free_cells[dis(gen)];
+            REQUIRE(reachable(s, t) == has_path(s, t));
+        }
+    }
+
+    SECTION("Changes through setOccupied, setFree and at() are seen") {
+        // a full column of occupied cells leaves both sides disconnected
+        const long int wall_x = -100;
+        std::mt19937 gen(2);
+        std::uniform_int_distribution<std::size_t> dis(0, free_cells.size() - 1);
+        Grid<>::Key s, t;
+        do { s = free_cells[dis(gen)]; t = free_cells[dis(gen)]; }
+        while (not (s.x < wall_x - I and t.x > wall_x + I and has_path(s, t)));
+        REQUIRE(reachable(s, t));
+        for (long int z = grid.dim.VMIN; z < grid.dim.VMIN + grid.dim.HEIGHT; z += I)
+            grid.setOccupied(Grid<>::Key(wall_x, z));
+        REQUIRE_FALSE(has_path(s, t));
+        REQUIRE_FALSE(reachable(s, t));
+
+        // reopening the whole column merges both sides again
+        for (long int z = grid.dim.VMIN; z < grid.dim.VMIN + grid.dim.HEIGHT; z += I)
+            grid.setFree(Grid<>::Key(wall_x, z));
+        REQUIRE(has_path(s, t));
+        REQUIRE(reachable(s, t));
+
+        // and closing it by inserting occupied cells is also tracked
+        for (long int z = grid.dim.VMIN; z < grid.dim.VMIN + grid.dim.HEIGHT; z += I)
+        {
+            const Grid<>::Key k(wall_x, z);
+            auto cell = grid.at(k);
+            cell.free = false;
+            grid.insert(k, cell);
+        }
+        REQUIRE_FALSE(has_path(s, t));
+        REQUIRE_FALSE(reachable(s, t));
+    }
+}
+
+TEST_CASE("Vector to the closest obstacle", "[GRID]") {
+
+    Grid<> grid;
+    grid.initialize(nullptr, nullptr, simscene_dimensions(), true, simscene_grid_file);
+    const int I = grid.dim.TILE_SIZE;
+    // random occupancy over the whole grid, so obstacles of every shape and isolated ones are present
+    std::mt19937 gen(3);
+    std::bernoulli_distribution occupied(0.1);
+    std::vector<Grid<>::Key> obstacles;
+    for (std::size_t i = 0; i < grid.size(); i++)
+    {
+        const auto k = grid.indexToKey(i);
+        if (occupied(gen)) { grid.setOccupied(k); obstacles.push_back(k); }
+        else grid.setFree(k);
+    }
+
+    SECTION("Matches a brute force scan for every cell, and never returns the cell itself") {
+        for (std::size_t i = 0; i < grid.size(); i++)
+        {
+            const auto k = grid.indexToKey(i);
+            long int best = std::numeric_limits<long int>::max();
+            for (const auto &o : obstacles)
+                if (not (o == k))
+                    best = std::min(best, (k.x - o.x) * (k.x - o.x) + (k.z - o.z) * (k.z - o.z));
+            const auto [found, vector] = grid.vectorToClosestObstacle(QPointF(k.x + I / 2, k.z + I / 2));
+            REQUIRE(found);
+            const long int vx = std::lround(vector.x()), vz = std::lround(vector.y());
+            REQUIRE_FALSE((vx == 0 and vz == 0));
+            REQUIRE(vx * vx + vz * vz == best);
+        }
+    }
+
+    SECTION("Follows cells freed after the first query") {
+        const auto k = obstacles.front();
+        REQUIRE(std::get<0>(grid.vectorToClosestObstacle(QPointF(k.x, k.z))));
+        for (const auto &o : obstacles)
+            grid.setFree(o);
+        REQUIRE_FALSE(std::get<0>(grid.vectorToClosestObstacle(QPointF(k.x, k.z))));
+    }
+}
@@ -156,14 +156,15 @@ std::cout<<"Update RT "<<name<<" "<<parent_name<<std::endl;
         else //create nodes
         {
             //qDebug() << __FUNCTION__ << "Person does not exist => Creation";
-            person_n = create_node("person", person_name, person.id, world_n->id());
+            person_n = create_node("person", person_name, person.id, world_n.value());
             if (not person_n.has_value()) 
                 std::terminate();
-            std::optional<Node> person_n_mesh = create_node_mesh(person_name, person1_path, person_n.value().id());
+            std::optional<Node> person_n_mesh = create_node_mesh(person_name, person1_path, person_n.value());
             if (not person_n_mesh.has_value()) 
                 std::terminate();
-            rt->insert_or_assign_edge_RT(world_n.value(), person_n->id(), std::vector<float>{person.x, person.y, person.z}, std::vector<float>{0.0, 0.0, 0.0});
-            rt->insert_or_assign_edge_RT(person_n.value(), person_n_mesh->id(), std::vector<float>{0.0, 0.0, 0.0}, std::vector<float>{1.5796,0.0, 0.0});
+            // parent and level were already set in the new nodes, so the RT edges go as plain edge deltas
+            create_edge_RT(world_n->id(), person_n->id(), std::vector<float>{person.x, person.y, person.z}, std::vector<float>{0.0, 0.0, 0.0});
+            create_edge_RT(person_n->id(), person_n_mesh->id(), std::vector<float>{0.0, 0.0, 0.0}, std::vector<float>{1.5796,0.0, 0.0});
             
             //create joints nodes
 /*            for(std::string name : COCO_IDS)
@@ -222,7 +223,8 @@ void SpecificWorker::check_unseen_people()
 	}
 }
 
-std::optional<Node> SpecificWorker::create_node(const std::string &type, const std::string &name, int person_id,  uint32_t parent_id)
+// parent is passed already read from G so its level is not fetched again for every new node
+std::optional<Node> SpecificWorker::create_node(const std::string &type, const std::string &name, int person_id, const Node &parent)
 {
     Node node;
     node.type(type);
@@ -232,8 +234,8 @@ std::optional<Node> SpecificWorker::create_node(const std::string &type, const s
     G->add_or_modify_attrib_local<pos_y_att>(node,  100.0f);
     G->add_or_modify_attrib_local<name_att>(node, name);
     G->add_or_modify_attrib_local<color_att>(node, std::string("GoldenRod"));
-    G->add_or_modify_attrib_local<parent_att>(node, parent_id);
-    G->add_or_modify_attrib_local<level_att>(node, G->get_node_level(  G->get_node(parent_id).value()    ).value() + 1);
+    G->add_or_modify_attrib_local<parent_att>(node, parent.id());
+    G->add_or_modify_attrib_local<level_att>(node, G->get_node_level(parent).value() + 1);
     //G->insert_or_assign_edge_RT(world_n.value(), person_n->id(), std::vector<float>{person.x, person.y, person.z}, std::vector<float>{0.0, 0.0, 0.0});
     try
     {
@@ -258,7 +260,7 @@ std::optional<Node> SpecificWorker::create_node(const std::string &type, const s
     }
 }
 
-std::optional<Node> SpecificWorker::create_node_mesh(const std::string &name, const std::string &path, uint32_t parent_id)
+std::optional<Node> SpecificWorker::create_node_mesh(const std::string &name, const std::string &path, const Node &parent)
 {
     Node node;
     node.type("mesh");
@@ -271,8 +273,8 @@ std::optional<Node> SpecificWorker::create_node_mesh(const std::string &name, co
     G->add_or_modify_attrib_local<scalex_att>(node, 900);
     G->add_or_modify_attrib_local<scaley_att>(node, 900);
     G->add_or_modify_attrib_local<scalez_att>(node,  900);
-    G->add_or_modify_attrib_local<parent_att>(node,  parent_id);
-    G->add_or_modify_attrib_local<level_att>(node, G->get_node_level( G->get_node(parent_id).value()).value() + 1);
+    G->add_or_modify_attrib_local<parent_att>(node,  parent.id());
+    G->add_or_modify_attrib_local<level_att>(node, G->get_node_level(parent).value() + 1);
     try
     {     
         std::optional<int> new_id = G->insert_node(node);
@@ -291,6 +293,17 @@ std::optional<Node> SpecificWorker::create_node_mesh(const std::string &name, co
     }
 }
 
+// RT_API::insert_or_assign_edge_RT also rewrites parent and level in the child node, publishing a second delta.
+// Nodes created here carry both attributes from birth, so the edge is built locally and sent in a single delta.
+void SpecificWorker::create_edge_RT(std::uint32_t from, std::uint32_t to, const std::vector<float> &trans, const std::vector<float> &rot)
+{
+    DSR::Edge edge(to, from, "RT", agent_id);
+    G->add_or_modify_attrib_local<rt_translation_att>(edge, trans);
+    G->add_or_modify_attrib_local<rt_rotation_euler_xyz_att>(edge, rot);
+    if (not G->insert_or_assign_edge(edge))
+        std::cout << __FUNCTION__ << " Error inserting new edge: " << from << "->" << to << " type: RT" << std::endl;
+}
+
 int SpecificWorker::startup_check()
 {
     std::cout << "Startup check" << std::endl;
@@ -109,8 +109,9 @@ private:
 
     DoubleBuffer<RoboCompHumanToDSRPub::PeopleData, RoboCompHumanToDSRPub::PeopleData> people_data_buffer;
     std::unordered_map<int, int> G_person_id;
-    std::optional<Node> create_node(const std::string &type, const std::string &name, int person_id,  uint32_t parent_idz);
-    std::optional<Node> create_node_mesh(const std::string &name, const std::string &path, uint32_t parent_id);
+    std::optional<Node> create_node(const std::string &type, const std::string &name, int person_id, const Node &parent);
+    std::optional<Node> create_node_mesh(const std::string &name, const std::string &path, const Node &parent);
+    void create_edge_RT(std::uint32_t from, std::uint32_t to, const std::vector<float> &trans, const std::vector<float> &rot);
     void process_people_data(RoboCompHumanToDSRPub::PeopleData people);
     void check_unseen_people();
 
@@ -105,6 +105,11 @@ void SpecificMonitor::readConfig(RoboCompCommonBehavior::ParameterList &params )
 	configGetString( "","3d_view", aux.value, "none");
 	params["3d_view"] = aux;
 
+	configGetString( "","publish_rgbd", aux.value, "true");
+	params["publish_rgbd"] = aux;
+	configGetString( "","publish_laser", aux.value, "true");
+	params["publish_laser"] = aux;
+
 }
 
 //Check parameters and transform them to worker structure
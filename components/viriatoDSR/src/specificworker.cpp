@@ -49,6 +49,8 @@ bool SpecificWorker::setParams(RoboCompCommonBehavior::ParameterList params)
 	graph_view = (params["graph_view"].value == "true") ? DSR::DSRViewer::view::graph : 0;
 	qscene_2d_view = (params["2d_view"].value == "true") ? DSR::DSRViewer::view::scene : 0;
 	osg_3d_view = (params["3d_view"].value == "true") ? DSR::DSRViewer::view::osg : 0;
+	publish_rgbd = params["publish_rgbd"].value != "false";
+	publish_laser = params["publish_laser"].value != "false";
 	return true;
 }
 
@@ -100,9 +102,12 @@ void SpecificWorker::initialize(int period)
 
 void SpecificWorker::compute()
 {
-    update_laser();
+    // kill-switches for the whole deployment: a disabled sensor is never written into G, so no agent gets it
+    if (publish_laser)
+        update_laser();
     update_omirobot();
-    update_rgbd();
+    if (publish_rgbd)
+        update_rgbd();
     update_pantilt_position();
     update_arm_state();
 
@@ -120,7 +125,8 @@ void SpecificWorker::update_rgbd()
     const  auto depth_o = depth_buffer.try_get();
     if (rgb_o.has_value() and depth_o.has_value())
     {
-        const auto rgb = rgb_o.value(); const auto depth = depth_o.value();
+        // frames are several MB each, so bind them instead of copying them out of the optionals
+        const auto &rgb = rgb_o.value(); const auto &depth = depth_o.value();
         auto node = G->get_node(viriato_head_camera_name);
         if (node.has_value())
         {
@@ -181,9 +187,9 @@ void SpecificWorker::update_omirobot()
         auto parent = G->get_parent_node(robot.value());
         if (not parent.has_value())
             qWarning() << __FUNCTION__ << " No parent found for node " << QString::fromStdString(robot_name);
-        if( are_different(std::vector<float>{bState.x, bState.z, bState.alpha},
-                          std::vector<float>{last_state.x, last_state.z, last_state.alpha},
-                          std::vector<float>{1, 1, 0.1}))
+        if( are_different<3>({bState.x, bState.z, bState.alpha},
+                             {last_state.x, last_state.z, last_state.alpha},
+                             {1, 1, 0.1}))
         {
             auto edge = rt->get_edge_RT(parent.value(), robot->id()).value();
             G->modify_attrib_local<rt_rotation_euler_xyz_att>(edge, std::vector<float>{0., 0, bState.alpha});
@@ -198,14 +204,14 @@ void SpecificWorker::update_omirobot()
 
 void SpecificWorker::update_pantilt_position()
 {
-    static std::vector<float> last_state{0.0, 0.0};
-    static std::vector<float> epsilon{0.01, 0.01};
+    static std::array<float, 2> last_state{0.0, 0.0};
+    static const std::array<float, 2> epsilon{0.01, 0.01};
 
     if (auto jointmotors_o = jointmotor_buffer.try_get(); jointmotors_o.has_value())
     {
         const float pan = jointmotors_o.value().at(viriato_head_camera_pan_joint).pos;
         const float tilt = jointmotors_o.value().at(viriato_head_camera_tilt_joint).pos;
-        const std::vector<float> current_state{pan, tilt};
+        const std::array<float, 2> current_state{pan, tilt};
         //qInfo() << pan << tilt;
         if( are_different(current_state, last_state, epsilon))
         {
@@ -317,14 +323,6 @@ void SpecificWorker::update_node_slot(const std::int32_t id, const std::string &
     }
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////
-bool SpecificWorker::are_different(const std::vector<float> &a, const std::vector<float> &b, const std::vector<float> &epsilon)
-{
-    for(auto &&[aa, bb, e] : iter::zip(a, b, epsilon))
-        if (fabs(aa - bb) > e)
-            return true;
-    return false;
-};
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 int SpecificWorker::startup_check()
 {
@@ -30,6 +30,7 @@
 #include "dsr/api/dsr_api.h"
 #include "dsr/gui/dsr_gui.h"
 #include <doublebuffer/DoubleBuffer.h>
+#include <array>
 #include  "../../../etc/viriato_graph_names.h"
 
 
@@ -88,6 +89,8 @@ private:
 	int graph_view;
 	int qscene_2d_view;
 	int osg_3d_view;
+	bool publish_rgbd;
+	bool publish_laser;
 
 	// Graph Viewer
 	std::unique_ptr<DSR::DSRViewer> dsr_viewer;
@@ -101,7 +104,15 @@ private:
     void update_pantilt_position();
     void update_arm_state();
 
-	bool are_different(const std::vector<float> &a, const std::vector<float> &b, const std::vector<float> &epsilon);
+	// fixed-size states, so the per-cycle change checks do not allocate
+	template<std::size_t N>
+	bool are_different(const std::array<float, N> &a, const std::array<float, N> &b, const std::array<float, N> &epsilon)
+	{
+		for(std::size_t i = 0; i < N; i++)
+			if (fabs(a[i] - b[i]) > epsilon[i])
+				return true;
+		return false;
+	}
 
     void check_new_nose_referece_for_pan_tilt();
 
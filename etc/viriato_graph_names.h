@@ -27,9 +27,12 @@ const std::string rgbd_type = "rgbd";
 const std::string left_hand_type = "left_hand";
 const std::string pan_tilt_type = "pan_tilt";
 const std::string glass_type = "glass";
+const std::string mesh_type = "mesh";
+const std::string plane_type = "plane";
 
 // EDGES TYPES
 const std::string think_type = "thinks";
 const std::string has_type = "has";
+const std::string rt_type = "RT";
 
 #endif
\ No newline at end of file